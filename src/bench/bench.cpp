@@ -0,0 +1,492 @@
+// Benchmark harness for S21Matrix, built and run by `make bench`.
+//
+// Every operation is timed over square matrices whose size doubles from
+// --min-size to --max-size. A measurement repeats the operation until
+// --min-time seconds have passed and reports the mean time per call, the
+// allocated bytes per call and GFLOP/s. GFLOP/s uses the nominal operation
+// count of the classical dense algorithm (2n^3 for a product, inverse and
+// complements, 2n^3/3 for a determinant, n^2 for element-wise operations),
+// so numbers stay comparable when an implementation changes. Operations
+// without arithmetic report 0. The batch_* operations instead run on a batch
+// of n independent 4x4 matrices.
+//
+// Sizes whose predicted run time exceeds --max-op-time seconds for a single
+// call are skipped. With --json the results are also written as JSON so that
+// runs of different releases can be compared.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../s21_matrix_batch.hpp"
+#include "../s21_matrix_io.hpp"
+#include "../s21_matrix_oop.hpp"
+#include "../s21_strassen.hpp"
+
+namespace {
+
+std::atomic<unsigned long long> allocated_bytes{0};
+
+void* CountedAlloc(std::size_t size, std::size_t alignment) {
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (size == 0) size = 1;
+  void* ptr = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    ptr = std::malloc(size);
+  } else {
+    ptr = std::aligned_alloc(alignment,
+                             (size + alignment - 1) / alignment * alignment);
+  }
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return CountedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return CountedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  int min_size = 2;
+  int max_size = 4096;
+  double min_time = 0.2;
+  double max_op_time = 5.0;
+  std::string json;
+  std::vector<std::string> ops;
+};
+
+struct Result {
+  std::string op;
+  int size;
+  long iterations;
+  double ns_per_op;
+  double gflops;
+  double bytes_per_op;
+};
+
+// One benchmarked operation: prepare builds the inputs for size n outside the
+// timed region and returns the callable that is timed.
+struct Benchmark {
+  std::string name;
+  // Exponent of n in the cost, used to predict the next size's run time
+  int order;
+  double (*flops)(double n);
+  std::function<std::function<void()>(int n)> prepare;
+};
+
+volatile double sink;
+
+void Fill(S21Matrix& matrix, int seed) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      matrix(i, j) = ((i * 31 + j * 17 + seed) % 23) / 23.0 - 0.5;
+    }
+    if (i < matrix.GetCols()) matrix(i, i) += matrix.GetCols();
+  }
+}
+
+double NoFlops(double) { return 0.0; }
+double ElementFlops(double n) { return n * n; }
+double CubicFlops(double n) { return 2.0 * n * n * n; }
+double DetFlops(double n) { return 2.0 * n * n * n / 3.0; }
+
+// Zeroes the elements outside the band and declares it
+void KeepBand(S21Matrix& matrix, int lower, int upper) {
+  int n = matrix.GetRows();
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (j < i - lower || j > i + upper) matrix(i, j) = 0.0;
+    }
+  }
+  matrix.SetBandwidth(std::min(n - 1, lower), std::min(n - 1, upper));
+}
+
+std::vector<Benchmark> AllBenchmarks() {
+  std::vector<Benchmark> list;
+  list.push_back({"mul_matrix", 3, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    auto b = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    Fill(*b, 2);
+                    return [a, b] {
+                      S21Matrix c = *a * *b;
+                      sink = c(0, 0);
+                    };
+                  }});
+  list.push_back({"mul_strassen", 3, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    auto b = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    Fill(*b, 2);
+                    return [a, b] {
+                      S21SetStrassenCutoff(512);
+                      S21Matrix c = *a * *b;
+                      S21SetStrassenCutoff(0);
+                      sink = c(0, 0);
+                    };
+                  }});
+  list.push_back({"mul_float", 3, CubicFlops, [](int n) {
+                    S21Matrix a(n, n), b(n, n);
+                    Fill(a, 1);
+                    Fill(b, 2);
+                    auto fa = std::make_shared<S21FloatMatrix>(a);
+                    auto fb = std::make_shared<S21FloatMatrix>(b);
+                    return [fa, fb] {
+                      S21FloatMatrix c = *fa * *fb;
+                      sink = c(0, 0);
+                    };
+                  }});
+  list.push_back({"gram_matrix", 3, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      S21Matrix c = a->Transposed() * *a;
+                      sink = c(0, 0);
+                    };
+                  }});
+  list.push_back({"transpose", 2, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      S21Matrix t = a->Transpose();
+                      sink = t(0, 0);
+                    };
+                  }});
+  list.push_back({"determinant", 3, DetFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] { sink = a->Determinant(); };
+                  }});
+  list.push_back({"log_determinant", 3, DetFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      int sign = 0;
+                      sink = a->LogDeterminant(sign);
+                    };
+                  }});
+  list.push_back({"calc_complements", 3, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      S21Matrix c = a->CalcComplements();
+                      sink = c(0, 0);
+                    };
+                  }});
+  list.push_back({"inverse_matrix", 3, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      S21Matrix inv = a->InverseMatrix();
+                      sink = inv(0, 0);
+                    };
+                  }});
+  list.push_back({"determinant_spd", 3, DetFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    *a = *a + a->Transposed();
+                    a->SetStructure(S21Structure::kPositiveDefinite);
+                    return [a] { sink = a->Determinant(); };
+                  }});
+  list.push_back({"inverse_spd", 3, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    *a = *a + a->Transposed();
+                    a->SetStructure(S21Structure::kPositiveDefinite);
+                    return [a] {
+                      S21Matrix inv = a->InverseMatrix();
+                      sink = inv(0, 0);
+                    };
+                  }});
+  list.push_back({"determinant_banded", 2, DetFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    KeepBand(*a, 2, 1);
+                    return [a] { sink = a->Determinant(); };
+                  }});
+  list.push_back({"mul_banded", 2, CubicFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    auto b = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    Fill(*b, 2);
+                    KeepBand(*a, 2, 1);
+                    return [a, b] {
+                      S21Matrix c = *a * *b;
+                      sink = c(0, 0);
+                    };
+                  }});
+  list.push_back({"sum_matrix", 2, ElementFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    auto b = std::make_shared<S21Matrix>(n, n);
+                    Fill(*b, 2);
+                    return [a, b] { a->SumMatrix(*b); };
+                  }});
+  list.push_back({"sub_matrix", 2, ElementFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    auto b = std::make_shared<S21Matrix>(n, n);
+                    Fill(*b, 2);
+                    return [a, b] { a->SubMatrix(*b); };
+                  }});
+  list.push_back({"mul_number", 2, ElementFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] { a->MulNumber(1.0); };
+                  }});
+  list.push_back({"fused_expression", 2,
+                  [](double n) { return 3.0 * n * n; },
+                  [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    auto b = std::make_shared<S21Matrix>(n, n);
+                    auto c = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    Fill(*b, 2);
+                    return [a, b, c] { *c = *a + *b * 2.0 - *a; };
+                  }});
+  list.push_back({"copy", 2, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      S21Matrix copy(*a);
+                      sink = copy(0, 0);
+                    };
+                  }});
+  list.push_back({"copy_pool", 2, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      S21AllocatorScope scope(S21PoolAllocator::Instance());
+                      S21Matrix copy(*a);
+                      sink = copy(0, 0);
+                    };
+                  }});
+  list.push_back({"copy_cow", 0, NoFlops, [](int n) {
+                    S21SetCopyOnWrite(true);
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    S21SetCopyOnWrite(false);
+                    Fill(*a, 1);
+                    return [a] {
+                      const S21Matrix copy(*a);
+                      sink = copy(0, 0);
+                    };
+                  }});
+  list.push_back({"move", 0, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    return [a] {
+                      S21Matrix moved(std::move(*a));
+                      *a = std::move(moved);
+                    };
+                  }});
+  list.push_back({"set_rows", 2, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a, n] {
+                      a->SetRows(n + 1);
+                      a->SetRows(n);
+                    };
+                  }});
+  list.push_back({"set_cols", 2, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a, n] {
+                      a->SetCols(n + 1);
+                      a->SetCols(n);
+                    };
+                  }});
+  list.push_back({"write_text", 2, NoFlops, [](int n) {
+                    auto a = std::make_shared<S21Matrix>(n, n);
+                    Fill(*a, 1);
+                    return [a] {
+                      std::ostringstream out;
+                      S21MatrixIO::WriteText(*a, out, ',');
+                      sink = static_cast<double>(out.tellp());
+                    };
+                  }});
+  list.push_back({"read_text", 2, NoFlops, [](int n) {
+                    S21Matrix a(n, n);
+                    Fill(a, 1);
+                    std::ostringstream out;
+                    S21MatrixIO::WriteText(a, out, ',');
+                    auto text = std::make_shared<std::string>(out.str());
+                    return [text] {
+                      std::istringstream in(*text);
+                      S21Matrix parsed = S21MatrixIO::ReadText(in);
+                      sink = parsed(0, 0);
+                    };
+                  }});
+  list.push_back({"batch_determinant", 1,
+                  [](double n) { return n * 2.0 * 64 / 3.0; }, [](int n) {
+                    auto a = std::make_shared<S21MatrixBatch>(n, 4, 4);
+                    for (int m = 0; m < n; m++) {
+                      S21Matrix matrix(4, 4);
+                      Fill(matrix, m);
+                      a->SetMatrix(m, matrix);
+                    }
+                    return [a] { sink = a->Determinant()[0]; };
+                  }});
+  list.push_back({"batch_inverse", 1, [](double n) { return n * 2.0 * 64; },
+                  [](int n) {
+                    auto a = std::make_shared<S21MatrixBatch>(n, 4, 4);
+                    for (int m = 0; m < n; m++) {
+                      S21Matrix matrix(4, 4);
+                      Fill(matrix, m);
+                      a->SetMatrix(m, matrix);
+                    }
+                    return [a] {
+                      S21MatrixBatch inv = a->InverseMatrix();
+                      sink = inv(0, 0, 0);
+                    };
+                  }});
+  return list;
+}
+
+Result Measure(const Benchmark& bench, int n, double min_time) {
+  std::function<void()> run = bench.prepare(n);
+  run();  // warm-up, also faults in lazily allocated memory
+
+  long iterations = 0;
+  unsigned long long bytes_before = allocated_bytes.load();
+  Clock::time_point start = Clock::now();
+  double elapsed = 0.0;
+  do {
+    run();
+    iterations++;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  } while (elapsed < min_time);
+  unsigned long long bytes = allocated_bytes.load() - bytes_before;
+
+  double ns = elapsed * 1e9 / iterations;
+  return {bench.name,
+          n,
+          iterations,
+          ns,
+          bench.flops(n) / ns,
+          static_cast<double>(bytes) / iterations};
+}
+
+bool Selected(const Options& options, const std::string& name) {
+  if (options.ops.empty()) return true;
+  for (const std::string& op : options.ops) {
+    if (op == name) return true;
+  }
+  return false;
+}
+
+void WriteJson(const std::string& path, const std::vector<Result>& results) {
+  std::ofstream out(path);
+  if (!out) {
+    std::fprintf(stderr, "Can't open %s for writing\n", path.c_str());
+    return;
+  }
+  out << "{\n  \"library\": \"s21_matrix_oop\",\n";
+  out << "  \"timestamp\": "
+      << std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+             .count()
+      << ",\n";
+  out << "  \"threads\": " << S21GetNumThreads() << ",\n";
+  out << "  \"results\": [\n";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    out << "    {\"op\": \"" << r.op << "\", \"size\": " << r.size
+        << ", \"iterations\": " << r.iterations
+        << ", \"ns_per_op\": " << r.ns_per_op << ", \"gflops\": " << r.gflops
+        << ", \"bytes_per_op\": " << r.bytes_per_op << "}"
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+}
+
+void Usage(const char* name) {
+  std::printf(
+      "Usage: %s [--min-size N] [--max-size N] [--min-time SEC]\n"
+      "          [--max-op-time SEC] [--ops op1,op2,...] [--json FILE]\n",
+      name);
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+    std::string value = argv[++i];
+    if (arg == "--min-size") {
+      options.min_size = std::atoi(value.c_str());
+    } else if (arg == "--max-size") {
+      options.max_size = std::atoi(value.c_str());
+    } else if (arg == "--min-time") {
+      options.min_time = std::atof(value.c_str());
+    } else if (arg == "--max-op-time") {
+      options.max_op_time = std::atof(value.c_str());
+    } else if (arg == "--json") {
+      options.json = value;
+    } else if (arg == "--ops") {
+      std::size_t start = 0;
+      while (start <= value.size()) {
+        std::size_t end = value.find(',', start);
+        if (end == std::string::npos) end = value.size();
+        options.ops.push_back(value.substr(start, end - start));
+        start = end + 1;
+      }
+    } else {
+      return false;
+    }
+  }
+  return options.min_size > 0 && options.max_size >= options.min_size;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  std::printf("%-18s %6s %10s %14s %10s %14s\n", "op", "size", "iters",
+              "ns/op", "GFLOP/s", "bytes/op");
+  std::vector<Result> results;
+  for (const Benchmark& bench : AllBenchmarks()) {
+    if (!Selected(options, bench.name)) continue;
+    for (int n = options.min_size; n <= options.max_size; n *= 2) {
+      Result r = Measure(bench, n, options.min_time);
+      results.push_back(r);
+      std::printf("%-18s %6d %10ld %14.1f %10.3f %14.0f\n", r.op.c_str(),
+                  r.size, r.iterations, r.ns_per_op, r.gflops,
+                  r.bytes_per_op);
+      std::fflush(stdout);
+
+      double next = r.ns_per_op * 1e-9 * (1 << bench.order);
+      if (next > options.max_op_time) {
+        std::printf("%-18s skipping sizes above %d\n", bench.name.c_str(), n);
+        break;
+      }
+    }
+  }
+
+  if (!options.json.empty()) WriteJson(options.json, results);
+  return 0;
+}
@@ -0,0 +1,234 @@
+#include "s21_allocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define S21_HAVE_MMAP 1
+#endif
+
+namespace {
+
+std::atomic<S21Allocator*> default_allocator{nullptr};
+std::atomic<bool> copy_on_write{false};
+thread_local S21Allocator* scoped_allocator = nullptr;
+
+std::size_t RoundUp(std::size_t bytes, std::size_t multiple) {
+  return (bytes + multiple - 1) / multiple * multiple;
+}
+
+// Pool classes: 64 bytes, then four classes per power of two,
+// 2^k * (1, 5/4, 3/2, 7/4), up to S21PoolAllocator::kMaxPooled
+constexpr int kMinShift = 6;
+constexpr int kMaxShift = 26;
+constexpr int kClasses = (kMaxShift - kMinShift) * 4 + 1;
+
+int ClassOf(std::size_t bytes) {
+  if (bytes <= (std::size_t{1} << kMinShift)) return 0;
+  int shift = kMinShift;
+  while ((std::size_t{2} << shift) <= bytes) shift++;
+  std::size_t base = std::size_t{1} << shift;
+  std::size_t step = base / 4;
+  int sub = static_cast<int>((bytes - base + step - 1) / step);
+  return (shift - kMinShift) * 4 + sub;
+}
+
+std::size_t ClassSize(int index) {
+  std::size_t base = std::size_t{1} << (kMinShift + index / 4);
+  return base + index % 4 * (base / 4);
+}
+
+struct ThreadCache {
+  ThreadCache() = default;
+  ThreadCache(const ThreadCache&) = delete;
+  ThreadCache& operator=(const ThreadCache&) = delete;
+  ~ThreadCache();
+
+  std::vector<void*> blocks[kClasses];
+};
+
+// Set once the calling thread's cache is destroyed; buffers freed after
+// that, by thread-local or static matrices, go straight back to the system
+thread_local bool cache_destroyed = false;
+thread_local ThreadCache cache;
+
+ThreadCache::~ThreadCache() {
+  for (int index = 0; index < kClasses; index++) {
+    for (void* block : blocks[index]) {
+      S21NewAllocator::Instance().Deallocate(block, ClassSize(index));
+    }
+  }
+  cache_destroyed = true;
+}
+
+}  // namespace
+
+S21NewAllocator& S21NewAllocator::Instance() {
+  static S21NewAllocator instance;
+  return instance;
+}
+
+void* S21NewAllocator::Allocate(std::size_t bytes) {
+  return ::operator new[](bytes, std::align_val_t(kAlignment));
+}
+
+void S21NewAllocator::Deallocate(void* data, std::size_t) {
+  ::operator delete[](data, std::align_val_t(kAlignment));
+}
+
+S21PoolAllocator& S21PoolAllocator::Instance() {
+  static S21PoolAllocator instance;
+  return instance;
+}
+
+void* S21PoolAllocator::Allocate(std::size_t bytes) {
+  if (bytes > kMaxPooled) return S21NewAllocator::Instance().Allocate(bytes);
+
+  int index = ClassOf(bytes);
+  if (!cache_destroyed && !cache.blocks[index].empty()) {
+    void* block = cache.blocks[index].back();
+    cache.blocks[index].pop_back();
+    return block;
+  }
+  return S21NewAllocator::Instance().Allocate(ClassSize(index));
+}
+
+void S21PoolAllocator::Deallocate(void* data, std::size_t bytes) {
+  if (bytes > kMaxPooled) {
+    S21NewAllocator::Instance().Deallocate(data, bytes);
+    return;
+  }
+
+  int index = ClassOf(bytes);
+  std::size_t limit =
+      std::max<std::size_t>(1, kCacheBytes / ClassSize(index));
+  if (cache_destroyed || cache.blocks[index].size() >= limit) {
+    S21NewAllocator::Instance().Deallocate(data, ClassSize(index));
+  } else {
+    cache.blocks[index].push_back(data);
+  }
+}
+
+S21ArenaAllocator::S21ArenaAllocator(std::size_t chunk_size)
+    : chunk_size_(RoundUp(std::max<std::size_t>(chunk_size, 1), kAlignment)),
+      chunks_(),
+      used_(0) {}
+
+S21ArenaAllocator::~S21ArenaAllocator() { Release(); }
+
+void* S21ArenaAllocator::Allocate(std::size_t bytes) {
+  bytes = RoundUp(std::max<std::size_t>(bytes, 1), kAlignment);
+  if (chunks_.empty() || chunks_.back().size - used_ < bytes) {
+    std::size_t size = std::max(chunk_size_, bytes);
+    chunks_.push_back(
+        {static_cast<char*>(S21NewAllocator::Instance().Allocate(size)),
+         size});
+    used_ = 0;
+  }
+  void* block = chunks_.back().data + used_;
+  used_ += bytes;
+  return block;
+}
+
+void S21ArenaAllocator::Deallocate(void* data, std::size_t bytes) {
+  bytes = RoundUp(std::max<std::size_t>(bytes, 1), kAlignment);
+  if (!chunks_.empty() && used_ >= bytes &&
+      data == chunks_.back().data + used_ - bytes) {
+    used_ -= bytes;
+  }
+}
+
+void S21ArenaAllocator::Release() {
+  for (const Chunk& chunk : chunks_) {
+    S21NewAllocator::Instance().Deallocate(chunk.data, chunk.size);
+  }
+  chunks_.clear();
+  used_ = 0;
+}
+
+std::size_t S21ArenaAllocator::GetCapacity() const {
+  std::size_t capacity = 0;
+  for (const Chunk& chunk : chunks_) capacity += chunk.size;
+  return capacity;
+}
+
+S21HugePageAllocator& S21HugePageAllocator::Instance() {
+  static S21HugePageAllocator instance;
+  return instance;
+}
+
+// Transparent huge pages only back ranges aligned to kHugePageSize, so the
+// mapping is over-allocated by one huge page and trimmed to an aligned range
+void* S21HugePageAllocator::Allocate(std::size_t bytes) {
+#ifdef S21_HAVE_MMAP
+  if (bytes >= kHugePageSize) {
+    std::size_t length = RoundUp(bytes, kHugePageSize);
+#ifdef MAP_HUGETLB
+    void* reserved = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (reserved != MAP_FAILED) return reserved;
+#endif
+    void* mapping = mmap(nullptr, length + kHugePageSize,
+                         PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1, 0);
+    if (mapping == MAP_FAILED) throw std::bad_alloc();
+
+    char* begin = static_cast<char*>(mapping);
+    char* aligned = begin + (kHugePageSize -
+                             reinterpret_cast<std::uintptr_t>(begin) %
+                                 kHugePageSize) %
+                                kHugePageSize;
+    if (aligned != begin) munmap(begin, aligned - begin);
+    std::size_t tail = kHugePageSize - (aligned - begin);
+    if (tail != 0) munmap(aligned + length, tail);
+#ifdef MADV_HUGEPAGE
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+    return aligned;
+  }
+#endif
+  return S21NewAllocator::Instance().Allocate(bytes);
+}
+
+void S21HugePageAllocator::Deallocate(void* data, std::size_t bytes) {
+#ifdef S21_HAVE_MMAP
+  if (bytes >= kHugePageSize) {
+    munmap(data, RoundUp(bytes, kHugePageSize));
+    return;
+  }
+#endif
+  S21NewAllocator::Instance().Deallocate(data, bytes);
+}
+
+void S21SetDefaultAllocator(S21Allocator* allocator) {
+  default_allocator.store(allocator, std::memory_order_release);
+}
+
+S21Allocator& S21CurrentAllocator() {
+  if (scoped_allocator != nullptr) return *scoped_allocator;
+  S21Allocator* allocator = default_allocator.load(std::memory_order_acquire);
+  return allocator != nullptr ? *allocator : S21NewAllocator::Instance();
+}
+
+void S21SetCopyOnWrite(bool enable) {
+  copy_on_write.store(enable, std::memory_order_relaxed);
+}
+
+bool S21GetCopyOnWrite() {
+  return copy_on_write.load(std::memory_order_relaxed);
+}
+
+S21AllocatorScope::S21AllocatorScope(S21Allocator& allocator)
+    : previous_(scoped_allocator) {
+  scoped_allocator = &allocator;
+}
+
+S21AllocatorScope::~S21AllocatorScope() { scoped_allocator = previous_; }
+
+S21ArenaScope::S21ArenaScope(std::size_t chunk_size)
+    : arena_(chunk_size), scope_(arena_) {}
+
+S21ArenaAllocator& S21ArenaScope::GetArena() { return arena_; }
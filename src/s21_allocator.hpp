@@ -0,0 +1,147 @@
+#ifndef S21_ALLOCATOR_HPP
+#define S21_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Source of matrix buffers. Every matrix takes the calling thread's current
+// allocator (see S21CurrentAllocator) when it allocates its buffer and
+// returns the buffer to that same allocator, so matrices from different
+// allocators mix freely. Blocks are aligned to kAlignment bytes.
+class S21Allocator {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  virtual ~S21Allocator() = default;
+  // Throws std::bad_alloc when no memory is available
+  virtual void* Allocate(std::size_t bytes) = 0;
+  // bytes is the size the block was allocated with
+  virtual void Deallocate(void* data, std::size_t bytes) = 0;
+  // Whether copy-on-write copies may share blocks from this allocator, see
+  // S21SetCopyOnWrite
+  virtual bool CanShare() const { return true; }
+};
+
+// Aligned global operator new and delete; the default
+class S21NewAllocator : public S21Allocator {
+ public:
+  static S21NewAllocator& Instance();
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* data, std::size_t bytes) override;
+};
+
+// Size-class pool with a cache per thread. Requests are rounded up to one
+// of four classes per power of two (at most 25% waste) and freed blocks
+// are kept in the freeing thread's cache for the next request of that
+// class, so steady-state matrix churn never reaches malloc or its locks.
+// Each thread caches at most about kCacheBytes per class; blocks above
+// kMaxPooled bytes bypass the pool.
+class S21PoolAllocator : public S21Allocator {
+ public:
+  static constexpr std::size_t kMaxPooled = std::size_t{1} << 26;
+  static constexpr std::size_t kCacheBytes = std::size_t{1} << 24;
+
+  static S21PoolAllocator& Instance();
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* data, std::size_t bytes) override;
+};
+
+// Bump allocator over large chunks. Deallocate only gives back the most
+// recent block (temporaries usually die in reverse order); everything else
+// is released at once by Release or the destructor, so every matrix
+// allocated from an arena must be gone by then. Not thread-safe.
+class S21ArenaAllocator : public S21Allocator {
+ public:
+  explicit S21ArenaAllocator(std::size_t chunk_size = std::size_t{1} << 20);
+  S21ArenaAllocator(const S21ArenaAllocator&) = delete;
+  S21ArenaAllocator& operator=(const S21ArenaAllocator&) = delete;
+  ~S21ArenaAllocator() override;
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* data, std::size_t bytes) override;
+  // Blocks die with the arena, so copies never share them
+  bool CanShare() const override { return false; }
+  void Release();
+  // Bytes of the chunks currently held
+  std::size_t GetCapacity() const;
+
+ private:
+  struct Chunk {
+    char* data;
+    std::size_t size;
+  };
+
+  std::size_t chunk_size_;
+  std::vector<Chunk> chunks_;
+  // Bytes in use in the last chunk
+  std::size_t used_;
+};
+
+// Maps blocks of at least kHugePageSize bytes straight from the kernel,
+// aligned to and rounded up to whole huge pages. Reserved huge pages are
+// used when there are any, otherwise transparent huge pages are requested,
+// so a large matrix needs 512 times fewer TLB entries. Smaller blocks, and
+// every block on systems without mmap, come from S21NewAllocator.
+class S21HugePageAllocator : public S21Allocator {
+ public:
+  static constexpr std::size_t kHugePageSize = std::size_t{1} << 21;
+
+  static S21HugePageAllocator& Instance();
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* data, std::size_t bytes) override;
+};
+
+// Allocator used by threads that have no S21AllocatorScope active.
+// nullptr restores S21NewAllocator. The allocator must outlive every
+// matrix allocated from it.
+void S21SetDefaultAllocator(S21Allocator* allocator);
+S21Allocator& S21CurrentAllocator();
+
+// Opt-in copy-on-write. While it is on, new matrix buffers carry an atomic
+// reference count and copying a matrix from such a buffer, by construction
+// or assignment, shares it instead of copying the elements. The first write
+// through any of the sharing matrices (operator(), an in-place operation,
+// growing it) gives that matrix a private copy first. Matrices sharing a
+// buffer may be used from different threads like independent copies.
+// A reference returned by operator() must not be written through once the
+// matrix has been copied, and a view keeps showing the shared elements after
+// a write moved its matrix to a private buffer. Buffers allocated while the
+// switch is off are copied as before.
+void S21SetCopyOnWrite(bool enable);
+bool S21GetCopyOnWrite();
+
+// Makes allocator the calling thread's current allocator until the scope
+// ends; scopes nest
+class S21AllocatorScope {
+ public:
+  explicit S21AllocatorScope(S21Allocator& allocator);
+  S21AllocatorScope(const S21AllocatorScope&) = delete;
+  S21AllocatorScope& operator=(const S21AllocatorScope&) = delete;
+  ~S21AllocatorScope();
+
+ private:
+  S21Allocator* previous_;
+};
+
+// Arena that serves every matrix buffer the calling thread allocates while
+// the scope lives, and frees them all together at its end. Matrices created
+// inside must not outlive it. To keep a result, assign it, by copy or move,
+// to a matrix that was created before the scope: the elements are copied
+// into that matrix's buffer, or into a new one from its own allocator when
+// they don't fit (see Reserve to avoid that allocation).
+class S21ArenaScope {
+ public:
+  explicit S21ArenaScope(std::size_t chunk_size = std::size_t{1} << 20);
+
+  S21ArenaAllocator& GetArena();
+
+ private:
+  S21ArenaAllocator arena_;
+  // Destroyed before arena_, restoring the previous allocator first
+  S21AllocatorScope scope_;
+};
+
+#endif
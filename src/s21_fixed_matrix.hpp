@@ -0,0 +1,394 @@
+#ifndef S21_FIXED_MATRIX_HPP
+#define S21_FIXED_MATRIX_HPP
+
+#include <stdexcept>
+
+#include "s21_matrix_oop.hpp"
+
+// Matrix whose dimensions are template parameters. Elements live inline in
+// the object, so no heap allocation happens, loops have constant trip
+// counts, and operations on mismatched shapes fail to compile instead of
+// throwing. CalcComplements and InverseMatrix use closed forms up to 4 x 4
+// and elimination on a stack copy beyond that. Determinant eliminates on a
+// stack copy at every size above 1 x 1 and, like S21Matrix, returns 0 once a
+// pivot falls below S21Matrix::kEpsilon, so both classes agree on which
+// matrices are singular.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Rows and columns must be > 0");
+
+ private:
+  template <int, int>
+  friend class S21FixedMatrix;
+
+  double matrix_[R][C];
+
+  S21FixedMatrix<C, R> Adjugate() const;
+  double GaussDet() const;
+  S21FixedMatrix GaussJordanInverse() const;
+
+ public:
+  // Constructors
+  constexpr S21FixedMatrix() : matrix_{} {}
+  explicit S21FixedMatrix(const S21Matrix& other);
+
+  // Methods
+  bool EqMatrix(const S21FixedMatrix& other) const;
+  void SumMatrix(const S21FixedMatrix& other);
+  void SubMatrix(const S21FixedMatrix& other);
+  void MulNumber(const double num);
+  void MulMatrix(const S21FixedMatrix<C, C>& other);
+  S21FixedMatrix<C, R> Transpose() const;
+  S21FixedMatrix CalcComplements() const;
+  S21FixedMatrix<R - (R > 1), C - (C > 1)> Minor(int a, int b) const;
+  double Determinant() const;
+  S21FixedMatrix InverseMatrix() const;
+
+  // Overloaded operators
+  S21FixedMatrix operator+(const S21FixedMatrix& other) const;
+  S21FixedMatrix operator-(const S21FixedMatrix& other) const;
+  template <int K>
+  S21FixedMatrix<R, K> operator*(const S21FixedMatrix<C, K>& other) const;
+  S21FixedMatrix operator*(const double num) const;
+  bool operator==(const S21FixedMatrix& other) const;
+  S21FixedMatrix& operator+=(const S21FixedMatrix& other);
+  S21FixedMatrix& operator-=(const S21FixedMatrix& other);
+  S21FixedMatrix& operator*=(const S21FixedMatrix<C, C>& other);
+  S21FixedMatrix& operator*=(const double num);
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+  explicit operator S21Matrix() const;
+
+  // Accessors
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+};
+
+template <int R, int C>
+S21FixedMatrix<R, C>::S21FixedMatrix(const S21Matrix& other) : matrix_{} {
+  if (other.GetRows() != R || other.GetCols() != C) {
+    throw std::logic_error("Can't convert matrix with different dimensions\n");
+  }
+  for (int i = 0; i < R; i++) {
+    for (int j = 0; j < C; j++) matrix_[i][j] = other(i, j);
+  }
+}
+
+template <int R, int C>
+bool S21FixedMatrix<R, C>::EqMatrix(const S21FixedMatrix& other) const {
+  for (int i = 0; i < R; i++) {
+    for (int j = 0; j < C; j++) {
+      if (S21Fabs(matrix_[i][j] - other.matrix_[i][j]) >=
+          S21Matrix::kEpsilon) return false;
+    }
+  }
+  return true;
+}
+
+template <int R, int C>
+void S21FixedMatrix<R, C>::SumMatrix(const S21FixedMatrix& other) {
+  for (int i = 0; i < R; i++) {
+    for (int j = 0; j < C; j++) matrix_[i][j] += other.matrix_[i][j];
+  }
+}
+
+template <int R, int C>
+void S21FixedMatrix<R, C>::SubMatrix(const S21FixedMatrix& other) {
+  for (int i = 0; i < R; i++) {
+    for (int j = 0; j < C; j++) matrix_[i][j] -= other.matrix_[i][j];
+  }
+}
+
+template <int R, int C>
+void S21FixedMatrix<R, C>::MulNumber(const double num) {
+  for (int i = 0; i < R; i++) {
+    for (int j = 0; j < C; j++) matrix_[i][j] *= num;
+  }
+}
+
+template <int R, int C>
+void S21FixedMatrix<R, C>::MulMatrix(const S21FixedMatrix<C, C>& other) {
+  *this = *this * other;
+}
+
+template <int R, int C>
+S21FixedMatrix<C, R> S21FixedMatrix<R, C>::Transpose() const {
+  S21FixedMatrix<C, R> result;
+  for (int i = 0; i < C; i++) {
+    for (int j = 0; j < R; j++) result.matrix_[i][j] = matrix_[j][i];
+  }
+  return result;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C> S21FixedMatrix<R, C>::CalcComplements() const {
+  static_assert(R == C, "Can't count matrix with different dimensions");
+  return Adjugate().Transpose();
+}
+
+template <int R, int C>
+S21FixedMatrix<R - (R > 1), C - (C > 1)> S21FixedMatrix<R, C>::Minor(
+    int a, int b) const {
+  S21FixedMatrix<R - (R > 1), C - (C > 1)> result;
+  for (int i = 0, row = 0; i < R; i++) {
+    if (i == a) continue;
+    for (int j = 0, col = 0; j < C; j++) {
+      if (j == b) continue;
+      result.matrix_[row][col++] = matrix_[i][j];
+    }
+    row++;
+  }
+  return result;
+}
+
+template <int R, int C>
+double S21FixedMatrix<R, C>::Determinant() const {
+  static_assert(R == C, "Can't count matrix with different dimensions");
+  if constexpr (R == 1) {
+    return matrix_[0][0];
+  } else {
+    return GaussDet();
+  }
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C> S21FixedMatrix<R, C>::InverseMatrix() const {
+  static_assert(R == C, "Can't count matrix with different dimensions");
+  double det = Determinant();
+  if (S21Fabs(det) < S21Matrix::kEpsilon) {
+    throw std::logic_error("Can't count matrix with its determinant = 0\n");
+  }
+  if constexpr (R <= 4) {
+    return Adjugate() * (1.0 / det);
+  } else {
+    return GaussJordanInverse();
+  }
+}
+
+// Transposed matrix of cofactors, written out for sizes up to 4 and built
+// from minors beyond that
+template <int R, int C>
+S21FixedMatrix<C, R> S21FixedMatrix<R, C>::Adjugate() const {
+  const double(&m)[R][C] = matrix_;
+  S21FixedMatrix<C, R> adj;
+  if constexpr (R == 1) {
+    adj.matrix_[0][0] = 1.0;
+  } else if constexpr (R == 2) {
+    adj.matrix_[0][0] = m[1][1], adj.matrix_[0][1] = -m[0][1];
+    adj.matrix_[1][0] = -m[1][0], adj.matrix_[1][1] = m[0][0];
+  } else if constexpr (R == 3) {
+    adj.matrix_[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    adj.matrix_[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+    adj.matrix_[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+    adj.matrix_[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    adj.matrix_[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+    adj.matrix_[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+    adj.matrix_[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    adj.matrix_[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+    adj.matrix_[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+  } else if constexpr (R == 4) {
+    double s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+    double s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+    double s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+    double s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+    double s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+    double s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+    double c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+    double c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+    double c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+    double c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+    double c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+    double c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+    adj.matrix_[0][0] = m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3;
+    adj.matrix_[0][1] = -m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3;
+    adj.matrix_[0][2] = m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3;
+    adj.matrix_[0][3] = -m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3;
+    adj.matrix_[1][0] = -m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1;
+    adj.matrix_[1][1] = m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1;
+    adj.matrix_[1][2] = -m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1;
+    adj.matrix_[1][3] = m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1;
+    adj.matrix_[2][0] = m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0;
+    adj.matrix_[2][1] = -m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0;
+    adj.matrix_[2][2] = m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0;
+    adj.matrix_[2][3] = -m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0;
+    adj.matrix_[3][0] = -m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0;
+    adj.matrix_[3][1] = m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0;
+    adj.matrix_[3][2] = -m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0;
+    adj.matrix_[3][3] = m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0;
+  } else {
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        double det = Minor(i, j).Determinant();
+        adj.matrix_[j][i] = (i + j) % 2 ? -det : det;
+      }
+    }
+  }
+  return adj;
+}
+
+template <int R, int C>
+double S21FixedMatrix<R, C>::GaussDet() const {
+  S21FixedMatrix temp(*this);
+  double result = 1.0;
+  for (int i = 0; i < R; i++) {
+    int pivot = i;
+    for (int k = i + 1; k < R; k++) {
+      if (S21Fabs(temp.matrix_[k][i]) > S21Fabs(temp.matrix_[pivot][i])) {
+        pivot = k;
+      }
+    }
+    if (S21Fabs(temp.matrix_[pivot][i]) < S21Matrix::kEpsilon) return 0.0;
+    if (pivot != i) {
+      for (int j = 0; j < C; j++) {
+        double swap = temp.matrix_[i][j];
+        temp.matrix_[i][j] = temp.matrix_[pivot][j];
+        temp.matrix_[pivot][j] = swap;
+      }
+      result = -result;
+    }
+    result *= temp.matrix_[i][i];
+    for (int k = i + 1; k < R; k++) {
+      double ratio = temp.matrix_[k][i] / temp.matrix_[i][i];
+      for (int j = i + 1; j < C; j++) {
+        temp.matrix_[k][j] -= ratio * temp.matrix_[i][j];
+      }
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C> S21FixedMatrix<R, C>::GaussJordanInverse() const {
+  S21FixedMatrix work(*this);
+  S21FixedMatrix result;
+  for (int i = 0; i < R; i++) result.matrix_[i][i] = 1.0;
+
+  for (int i = 0; i < R; i++) {
+    int pivot = i;
+    for (int k = i + 1; k < R; k++) {
+      if (S21Fabs(work.matrix_[k][i]) > S21Fabs(work.matrix_[pivot][i])) {
+        pivot = k;
+      }
+    }
+    for (int j = 0; j < C; j++) {
+      double swap = work.matrix_[i][j];
+      work.matrix_[i][j] = work.matrix_[pivot][j];
+      work.matrix_[pivot][j] = swap;
+      swap = result.matrix_[i][j];
+      result.matrix_[i][j] = result.matrix_[pivot][j];
+      result.matrix_[pivot][j] = swap;
+    }
+    double scale = 1.0 / work.matrix_[i][i];
+    for (int j = 0; j < C; j++) {
+      work.matrix_[i][j] *= scale;
+      result.matrix_[i][j] *= scale;
+    }
+    for (int k = 0; k < R; k++) {
+      double ratio = work.matrix_[k][i];
+      if (k == i || ratio == 0.0) continue;
+      for (int j = 0; j < C; j++) {
+        work.matrix_[k][j] -= ratio * work.matrix_[i][j];
+        result.matrix_[k][j] -= ratio * result.matrix_[i][j];
+      }
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C> S21FixedMatrix<R, C>::operator+(
+    const S21FixedMatrix& other) const {
+  S21FixedMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C> S21FixedMatrix<R, C>::operator-(
+    const S21FixedMatrix& other) const {
+  S21FixedMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+template <int R, int C>
+template <int K>
+S21FixedMatrix<R, K> S21FixedMatrix<R, C>::operator*(
+    const S21FixedMatrix<C, K>& other) const {
+  S21FixedMatrix<R, K> result;
+  for (int i = 0; i < R; i++) {
+    for (int k = 0; k < C; k++) {
+      double aik = matrix_[i][k];
+      for (int j = 0; j < K; j++) {
+        result.matrix_[i][j] += aik * other.matrix_[k][j];
+      }
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C> S21FixedMatrix<R, C>::operator*(const double num) const {
+  S21FixedMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+template <int R, int C>
+bool S21FixedMatrix<R, C>::operator==(const S21FixedMatrix& other) const {
+  return EqMatrix(other);
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C>& S21FixedMatrix<R, C>::operator+=(
+    const S21FixedMatrix& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C>& S21FixedMatrix<R, C>::operator-=(
+    const S21FixedMatrix& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C>& S21FixedMatrix<R, C>::operator*=(
+    const S21FixedMatrix<C, C>& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C>& S21FixedMatrix<R, C>::operator*=(const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+template <int R, int C>
+double& S21FixedMatrix<R, C>::operator()(int row, int col) {
+  if (row >= R || col >= C || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return matrix_[row][col];
+}
+
+template <int R, int C>
+double S21FixedMatrix<R, C>::operator()(int row, int col) const {
+  if (row >= R || col >= C || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return matrix_[row][col];
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C>::operator S21Matrix() const {
+  S21Matrix result(R, C);
+  for (int i = 0; i < R; i++) {
+    for (int j = 0; j < C; j++) result(i, j) = matrix_[i][j];
+  }
+  return result;
+}
+
+#endif
@@ -0,0 +1,397 @@
+#include "s21_gemm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "s21_thread_pool.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_GEMM_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kAlignment = 64;
+
+// Register block of the micro-kernel: kMR rows of A times kNR columns of B,
+// where a row of the block fills one cache line (8 doubles, 16 floats or 4 long
+// doubles).
+constexpr int kMR = 6;
+template <typename T>
+constexpr int kNR = static_cast<int>(kAlignment / sizeof(T));
+
+// Cache blocking: a kKC x kNR sliver of B stays in L1, a kMC x kKC block of A
+// in L2 and a kKC x kNC panel of B in L3.
+constexpr int kMC = 72;
+constexpr int kKC = 256;
+constexpr int kNC = 4080;
+
+// Products smaller than this many multiply-adds skip packing entirely, and
+// products smaller than kParallelProduct stay on the calling thread.
+constexpr long kSmallProduct = 16 * 16 * 16;
+constexpr long kParallelProduct = 96 * 96 * 96;
+
+template <typename T>
+using MicroKernel = void (*)(int kc, const T* a, const T* b, T* c,
+                             std::ptrdiff_t ldc, bool accumulate);
+
+template <typename T>
+class PackBuffer {
+ public:
+  PackBuffer() : data_(nullptr), size_(0) {}
+  PackBuffer(const PackBuffer&) = delete;
+  PackBuffer& operator=(const PackBuffer&) = delete;
+  ~PackBuffer() { Release(); }
+
+  T* Get(std::size_t size) {
+    if (size > size_) {
+      Release();
+      data_ = static_cast<T*>(
+          ::operator new[](size * sizeof(T), std::align_val_t(kAlignment)));
+      size_ = size;
+    }
+    return data_;
+  }
+
+ private:
+  void Release() {
+    if (data_ != nullptr) {
+      ::operator delete[](data_, std::align_val_t(kAlignment));
+    }
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  T* data_;
+  std::size_t size_;
+};
+
+// Packs an mc x kc block of A into kMR-row panels, each stored column by
+// column; rows past mc are zero-filled so the micro-kernel never branches.
+template <typename T>
+void PackA(int mc, int kc, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+           T* dst) {
+  for (int ir = 0; ir < mc; ir += kMR) {
+    int mr = std::min(kMR, mc - ir);
+    for (int p = 0; p < kc; p++) {
+      const T* src = a + ir * rsa + p * csa;
+      for (int i = 0; i < mr; i++) dst[i] = src[i * rsa];
+      for (int i = mr; i < kMR; i++) dst[i] = 0;
+      dst += kMR;
+    }
+  }
+}
+
+// Packs a kc x nc panel of B into kNR-column slivers, each stored row by row.
+template <typename T>
+void PackB(int kc, int nc, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+           T* dst) {
+  for (int jr = 0; jr < nc; jr += kNR<T>) {
+    int nr = std::min(kNR<T>, nc - jr);
+    for (int p = 0; p < kc; p++) {
+      const T* src = b + p * rsb + jr * csb;
+      for (int j = 0; j < nr; j++) dst[j] = src[j * csb];
+      for (int j = nr; j < kNR<T>; j++) dst[j] = 0;
+      dst += kNR<T>;
+    }
+  }
+}
+
+template <typename T>
+void MicroKernelScalar(int kc, const T* a, const T* b, T* c,
+                       std::ptrdiff_t ldc, bool accumulate) {
+  T ab[kMR][kNR<T>] = {};
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kMR; i++) {
+      T ai = a[i];
+      for (int j = 0; j < kNR<T>; j++) ab[i][j] += ai * b[j];
+    }
+    a += kMR;
+    b += kNR<T>;
+  }
+  for (int i = 0; i < kMR; i++) {
+    T* row = c + i * ldc;
+    for (int j = 0; j < kNR<T>; j++) {
+      row[j] = accumulate ? row[j] + ab[i][j] : ab[i][j];
+    }
+  }
+}
+
+#ifdef S21_GEMM_AVX2
+__attribute__((target("avx2,fma"))) void MicroKernelAvx2(
+    int kc, const double* a, const double* b, double* c, std::ptrdiff_t ldc,
+    bool accumulate) {
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+  __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+  __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+  for (int p = 0; p < kc; p++) {
+    __m256d b0 = _mm256_load_pd(b);
+    __m256d b1 = _mm256_load_pd(b + 4);
+    __m256d ai = _mm256_broadcast_sd(a);
+    c00 = _mm256_fmadd_pd(ai, b0, c00);
+    c01 = _mm256_fmadd_pd(ai, b1, c01);
+    ai = _mm256_broadcast_sd(a + 1);
+    c10 = _mm256_fmadd_pd(ai, b0, c10);
+    c11 = _mm256_fmadd_pd(ai, b1, c11);
+    ai = _mm256_broadcast_sd(a + 2);
+    c20 = _mm256_fmadd_pd(ai, b0, c20);
+    c21 = _mm256_fmadd_pd(ai, b1, c21);
+    ai = _mm256_broadcast_sd(a + 3);
+    c30 = _mm256_fmadd_pd(ai, b0, c30);
+    c31 = _mm256_fmadd_pd(ai, b1, c31);
+    ai = _mm256_broadcast_sd(a + 4);
+    c40 = _mm256_fmadd_pd(ai, b0, c40);
+    c41 = _mm256_fmadd_pd(ai, b1, c41);
+    ai = _mm256_broadcast_sd(a + 5);
+    c50 = _mm256_fmadd_pd(ai, b0, c50);
+    c51 = _mm256_fmadd_pd(ai, b1, c51);
+    a += kMR;
+    b += kNR<double>;
+  }
+
+  __m256d acc[kMR][2] = {{c00, c01}, {c10, c11}, {c20, c21},
+                         {c30, c31}, {c40, c41}, {c50, c51}};
+  for (int i = 0; i < kMR; i++) {
+    double* row = c + i * ldc;
+    if (accumulate) {
+      acc[i][0] = _mm256_add_pd(acc[i][0], _mm256_loadu_pd(row));
+      acc[i][1] = _mm256_add_pd(acc[i][1], _mm256_loadu_pd(row + 4));
+    }
+    _mm256_storeu_pd(row, acc[i][0]);
+    _mm256_storeu_pd(row + 4, acc[i][1]);
+  }
+}
+
+// Same register block as the double kernel with twice the lanes per
+// register, so a sliver of B is 16 floats wide
+__attribute__((target("avx2,fma"))) void MicroKernelAvx2(
+    int kc, const float* a, const float* b, float* c, std::ptrdiff_t ldc,
+    bool accumulate) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+  for (int p = 0; p < kc; p++) {
+    __m256 b0 = _mm256_load_ps(b);
+    __m256 b1 = _mm256_load_ps(b + 8);
+    __m256 ai = _mm256_broadcast_ss(a);
+    c00 = _mm256_fmadd_ps(ai, b0, c00);
+    c01 = _mm256_fmadd_ps(ai, b1, c01);
+    ai = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(ai, b0, c10);
+    c11 = _mm256_fmadd_ps(ai, b1, c11);
+    ai = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(ai, b0, c20);
+    c21 = _mm256_fmadd_ps(ai, b1, c21);
+    ai = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(ai, b0, c30);
+    c31 = _mm256_fmadd_ps(ai, b1, c31);
+    ai = _mm256_broadcast_ss(a + 4);
+    c40 = _mm256_fmadd_ps(ai, b0, c40);
+    c41 = _mm256_fmadd_ps(ai, b1, c41);
+    ai = _mm256_broadcast_ss(a + 5);
+    c50 = _mm256_fmadd_ps(ai, b0, c50);
+    c51 = _mm256_fmadd_ps(ai, b1, c51);
+    a += kMR;
+    b += kNR<float>;
+  }
+
+  __m256 acc[kMR][2] = {{c00, c01}, {c10, c11}, {c20, c21},
+                        {c30, c31}, {c40, c41}, {c50, c51}};
+  for (int i = 0; i < kMR; i++) {
+    float* row = c + i * ldc;
+    if (accumulate) {
+      acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_loadu_ps(row));
+      acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_loadu_ps(row + 8));
+    }
+    _mm256_storeu_ps(row, acc[i][0]);
+    _mm256_storeu_ps(row + 8, acc[i][1]);
+  }
+}
+
+bool CpuHasAvx2() {
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+#endif
+
+// SIMD micro-kernel for T, or nullptr when there is none for this type or
+// this CPU. long double always runs the scalar kernel.
+template <typename T>
+MicroKernel<T> SimdKernel() {
+  return nullptr;
+}
+
+#ifdef S21_GEMM_AVX2
+template <>
+MicroKernel<double> SimdKernel<double>() {
+  if (!CpuHasAvx2()) return nullptr;
+  return MicroKernelAvx2;
+}
+
+template <>
+MicroKernel<float> SimdKernel<float>() {
+  if (!CpuHasAvx2()) return nullptr;
+  return MicroKernelAvx2;
+}
+#endif
+
+template <typename T>
+MicroKernel<T> SelectKernel(bool simd) {
+  MicroKernel<T> kernel = simd ? SimdKernel<T>() : nullptr;
+  return kernel != nullptr ? kernel : MicroKernelScalar<T>;
+}
+
+// Atomic so that S21GemmSetSimd may switch kernels while other threads are
+// multiplying; a call in flight finishes with the kernel it loaded
+template <typename T>
+std::atomic<MicroKernel<T>>& ActiveKernel() {
+  static std::atomic<MicroKernel<T>> kernel{SelectKernel<T>(true)};
+  return kernel;
+}
+
+// Multiplies a packed mc x kc block of A by a packed kc x nc panel of B into
+// C. Edge tiles are computed into a scratch tile and copied out partially.
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, const T* a_packed, const T* b_packed,
+                 T* c, std::ptrdiff_t ldc, bool accumulate) {
+  MicroKernel<T> kernel = ActiveKernel<T>().load(std::memory_order_relaxed);
+  alignas(kAlignment) T tile[kMR * kNR<T>];
+
+  for (int jr = 0; jr < nc; jr += kNR<T>) {
+    int nr = std::min(kNR<T>, nc - jr);
+    for (int ir = 0; ir < mc; ir += kMR) {
+      int mr = std::min(kMR, mc - ir);
+      const T* a = a_packed + ir * kc;
+      const T* b = b_packed + jr * kc;
+      T* dst = c + ir * ldc + jr;
+      if (mr == kMR && nr == kNR<T>) {
+        kernel(kc, a, b, dst, ldc, accumulate);
+      } else {
+        kernel(kc, a, b, tile, kNR<T>, false);
+        for (int i = 0; i < mr; i++) {
+          for (int j = 0; j < nr; j++) {
+            T value = tile[i * kNR<T> + j];
+            dst[i * ldc + j] = accumulate ? dst[i * ldc + j] + value : value;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void SmallGemm(int m, int n, int k, const T* a, std::ptrdiff_t rsa,
+               std::ptrdiff_t csa, const T* b, std::ptrdiff_t rsb,
+               std::ptrdiff_t csb, T* c, std::ptrdiff_t ldc,
+               bool accumulate) {
+  for (int i = 0; i < m; i++) {
+    T* row = c + i * ldc;
+    if (!accumulate) std::fill(row, row + n, T(0));
+    for (int p = 0; p < k; p++) {
+      T aip = a[i * rsa + p * csa];
+      const T* src = b + p * rsb;
+      for (int j = 0; j < n; j++) row[j] += aip * src[j * csb];
+    }
+  }
+}
+
+template <typename T>
+void Gemm(int m, int n, int k, const T* a, std::ptrdiff_t rsa,
+          std::ptrdiff_t csa, const T* b, std::ptrdiff_t rsb,
+          std::ptrdiff_t csb, T* c, std::ptrdiff_t ldc, bool accumulate) {
+  if (m <= 0 || n <= 0) return;
+  if (k <= 0 || static_cast<long>(m) * n * k <= kSmallProduct) {
+    SmallGemm(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, accumulate);
+    return;
+  }
+
+  // The packed B panel is shared by all threads, which split C into tiles
+  // of one row block by one column panel. Each thread packs the row blocks
+  // of A it needs into its own buffer. The panel is only cut into narrower
+  // columns when there are fewer row blocks than threads, so short, wide
+  // products keep every thread busy while tall ones pack every block once.
+  thread_local PackBuffer<T> b_buffer;
+  T* b_packed = b_buffer.Get(static_cast<std::size_t>(kKC) * kNC);
+  int row_blocks = (m + kMC - 1) / kMC;
+  bool parallel = static_cast<long>(m) * n * k >= kParallelProduct;
+  int threads = parallel ? S21ThreadPool::Instance().GetThreadCount() : 1;
+
+  for (int jc = 0; jc < n; jc += kNC) {
+    int nc = std::min(kNC, n - jc);
+    int slivers = (nc + kNR<T> - 1) / kNR<T>;
+    int panels = std::min(slivers, (threads + row_blocks - 1) / row_blocks);
+    int panel_width = (slivers + panels - 1) / panels * kNR<T>;
+    panels = (nc + panel_width - 1) / panel_width;
+
+    for (int pc = 0; pc < k; pc += kKC) {
+      int kc = std::min(kKC, k - pc);
+      PackB(kc, nc, b + pc * rsb + jc * csb, rsb, csb, b_packed);
+
+      auto tiles = [&](int first, int last) {
+        thread_local PackBuffer<T> a_buffer;
+        T* a_packed = a_buffer.Get(static_cast<std::size_t>(kMC) * kKC);
+        int packed_block = -1;
+        for (int tile = first; tile < last; tile++) {
+          int block = tile / panels;
+          int ic = block * kMC;
+          int mc = std::min(kMC, m - ic);
+          int jr = tile % panels * panel_width;
+          int nr = std::min(panel_width, nc - jr);
+          if (block != packed_block) {
+            PackA(mc, kc, a + ic * rsa + pc * csa, rsa, csa, a_packed);
+            packed_block = block;
+          }
+          MacroKernel(mc, nr, kc, a_packed, b_packed + jr * kc,
+                      c + ic * ldc + jc + jr, ldc, accumulate || pc != 0);
+        }
+      };
+      if (parallel) {
+        S21ThreadPool::Instance().ParallelFor(0, row_blocks * panels, 1,
+                                              tiles);
+      } else {
+        tiles(0, row_blocks * panels);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void S21Gemm(int m, int n, int k, const float* a, std::ptrdiff_t rsa,
+             std::ptrdiff_t csa, const float* b, std::ptrdiff_t rsb,
+             std::ptrdiff_t csb, float* c, std::ptrdiff_t ldc,
+             bool accumulate) {
+  Gemm(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, accumulate);
+}
+
+void S21Gemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+             std::ptrdiff_t csa, const double* b, std::ptrdiff_t rsb,
+             std::ptrdiff_t csb, double* c, std::ptrdiff_t ldc,
+             bool accumulate) {
+  Gemm(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, accumulate);
+}
+
+void S21Gemm(int m, int n, int k, const long double* a, std::ptrdiff_t rsa,
+             std::ptrdiff_t csa, const long double* b, std::ptrdiff_t rsb,
+             std::ptrdiff_t csb, long double* c, std::ptrdiff_t ldc,
+             bool accumulate) {
+  Gemm(m, n, k, a, rsa, csa, b, rsb, csb, c, ldc, accumulate);
+}
+
+bool S21GemmSetSimd(bool enable) {
+  ActiveKernel<float>().store(SelectKernel<float>(enable),
+                              std::memory_order_relaxed);
+  ActiveKernel<double>().store(SelectKernel<double>(enable),
+                               std::memory_order_relaxed);
+  return ActiveKernel<double>().load(std::memory_order_relaxed) !=
+         MicroKernelScalar<double>;
+}
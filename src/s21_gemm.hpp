@@ -0,0 +1,33 @@
+#ifndef S21_GEMM_HPP
+#define S21_GEMM_HPP
+
+#include <cstddef>
+
+// C = A * B, or C += A * B when accumulate is set, where A is m x k, B is
+// k x n and C is m x n with leading dimension ldc. A and B are addressed
+// through separate row and column strides, so element (i, j) of A is
+// a[i * rsa + j * csa]; this lets callers pass transposed or strided operands
+// without copying them first.
+//
+// float and double have AVX2/FMA micro-kernels; long double always runs the
+// portable one.
+void S21Gemm(int m, int n, int k, const float* a, std::ptrdiff_t rsa,
+             std::ptrdiff_t csa, const float* b, std::ptrdiff_t rsb,
+             std::ptrdiff_t csb, float* c, std::ptrdiff_t ldc,
+             bool accumulate = false);
+void S21Gemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+             std::ptrdiff_t csa, const double* b, std::ptrdiff_t rsb,
+             std::ptrdiff_t csb, double* c, std::ptrdiff_t ldc,
+             bool accumulate = false);
+void S21Gemm(int m, int n, int k, const long double* a, std::ptrdiff_t rsa,
+             std::ptrdiff_t csa, const long double* b, std::ptrdiff_t rsb,
+             std::ptrdiff_t csb, long double* c, std::ptrdiff_t ldc,
+             bool accumulate = false);
+
+// Enables or disables the AVX2/FMA micro-kernels. Returns whether the SIMD
+// kernels are in use afterwards (they stay off on CPUs that lack AVX2/FMA).
+// May be called while other threads multiply; products already running keep
+// the kernel they started with.
+bool S21GemmSetSimd(bool enable);
+
+#endif
@@ -0,0 +1,209 @@
+#include "s21_lu.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "s21_gemm.hpp"
+#include "s21_thread_pool.hpp"
+
+namespace {
+
+// Right-hand sides are solved in bands of this many columns, one band per
+// task, so wide systems keep every thread busy without synchronisation.
+constexpr int kSolveBand = 256;
+
+}  // namespace
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T>& matrix)
+    : lu_(matrix), pivots_(), sign_(1), singular_(false) {
+  if (matrix.rows_ != matrix.cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+  Factor();
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSize() const { return lu_.rows_; }
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const { return singular_; }
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const {
+  if (singular_) return 0;
+  return sign_ * lu_.PivotProduct(false);
+}
+
+template <typename T>
+T S21BasicLU<T>::LogDeterminant(int& sign) const {
+  if (singular_) {
+    sign = 0;
+    return -std::numeric_limits<T>::infinity();
+  }
+
+  T result = lu_.LogPivotProduct(sign, false);
+  sign *= sign_;
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  if (singular_) {
+    throw std::logic_error("Can't count matrix with its determinant = 0\n");
+  }
+
+  int n = lu_.rows_;
+  S21BasicMatrix<T> result(n, n);
+  for (int i = 0; i < n; i++) result.Row(i)[i] = 1;
+  SolveInPlace(result);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T>& b) const {
+  if (b.rows_ != lu_.rows_) {
+    throw std::logic_error(
+        "Can't solve a system with right-hand side rows count not being "
+        "equal to matrix size\n");
+  }
+  if (singular_) {
+    throw std::logic_error("Can't solve a system with a singular matrix\n");
+  }
+
+  S21BasicMatrix<T> result(b);
+  SolveInPlace(result);
+  return result;
+}
+
+template <typename T>
+void S21BasicLU<T>::Factor() {
+  lu_.Detach();
+  pivots_.resize(lu_.rows_);
+  if (lu_.rows_ < kBlockedSize) {
+    FactorPanel(0, lu_.rows_);
+  } else {
+    FactorBlocked();
+  }
+}
+
+// Eliminates columns first .. last - 1. Row swaps cover whole rows, but the
+// updates stop at column last; columns further right are the caller's.
+template <typename T>
+void S21BasicLU<T>::FactorPanel(int first, int last) {
+  int n = lu_.rows_;
+  for (int i = first; i < last; i++) {
+    int pivot = i;
+    for (int k = i + 1; k < n; k++) {
+      if (S21Fabs(lu_.Row(k)[i]) > S21Fabs(lu_.Row(pivot)[i])) pivot = k;
+    }
+    pivots_[i] = pivot;
+    if (pivot != i) {
+      lu_.SwapZeroPivot(lu_, pivot, i);
+      sign_ = -sign_;
+    }
+
+    const T* pivot_row = lu_.Row(i);
+    if (pivot_row[i] == 0) {
+      singular_ = true;
+      continue;
+    }
+
+    T scale = 1 / pivot_row[i];
+    S21ForEachRowBand(n - i - 1, last - i, [&](int begin, int end) {
+      for (int k = i + 1 + begin; k < i + 1 + end; k++) {
+        T* row = lu_.Row(k);
+        T ratio = row[i] * scale;
+        row[i] = ratio;
+        if (ratio == 0) continue;
+        for (int j = i + 1; j < last; j++) row[j] -= ratio * pivot_row[j];
+      }
+    });
+  }
+}
+
+// Right-looking blocked elimination. After a panel is factored, the rows of
+// the panel right of it become U12 = L11^-1 * A12, and the trailing matrix
+// takes A22 -= L21 * U12 as one GEMM, which does nearly all of the flops at
+// the kernel's rate and on every thread.
+template <typename T>
+void S21BasicLU<T>::FactorBlocked() {
+  int n = lu_.rows_;
+  std::vector<T> l21;
+  for (int k = 0; k < n; k += kPanel) {
+    int end = std::min(n, k + kPanel);
+    FactorPanel(k, end);
+    int width = end - k, rest = n - end;
+    if (rest == 0) break;
+
+    int bands = (rest + kSolveBand - 1) / kSolveBand;
+    S21ThreadPool::Instance().ParallelFor(
+        0, bands, 1, [&](int first, int last) {
+          int begin = end + first * kSolveBand;
+          int stop = std::min(n, end + last * kSolveBand);
+          for (int i = k + 1; i < end; i++) {
+            T* row = lu_.Row(i);
+            for (int p = k; p < i; p++) {
+              const T* src = lu_.Row(p);
+              T factor = row[p];
+              if (factor == 0) continue;
+              for (int j = begin; j < stop; j++) row[j] -= factor * src[j];
+            }
+          }
+        });
+
+    // -L21 packed row by row turns the update into C += A * B
+    l21.resize(static_cast<std::size_t>(rest) * width);
+    for (int i = 0; i < rest; i++) {
+      const T* src = lu_.Row(end + i) + k;
+      for (int p = 0; p < width; p++) l21[i * width + p] = -src[p];
+    }
+    S21Gemm(rest, rest, width, l21.data(), width, 1, lu_.Row(k) + end,
+            lu_.stride_, 1, lu_.Row(end) + end, lu_.stride_, true);
+  }
+}
+
+// Applies the row interchanges, then forward substitution with the unit
+// lower factor and back substitution with the upper one. Each step is an
+// update of a whole row of x, so the inner loops run over contiguous memory.
+template <typename T>
+void S21BasicLU<T>::SolveInPlace(S21BasicMatrix<T>& x) const {
+  int n = lu_.rows_;
+  x.Detach();
+  for (int i = 0; i < n; i++) {
+    if (pivots_[i] != i) x.SwapZeroPivot(x, i, pivots_[i]);
+  }
+
+  int bands = (x.cols_ + kSolveBand - 1) / kSolveBand;
+  S21ThreadPool::Instance().ParallelFor(0, bands, 1, [&](int first, int last) {
+    int begin = first * kSolveBand;
+    int end = std::min(x.cols_, last * kSolveBand);
+
+    for (int i = 1; i < n; i++) {
+      const T* l = lu_.Row(i);
+      T* row = x.Row(i);
+      for (int k = 0; k < i; k++) {
+        const T* src = x.Row(k);
+        T factor = l[k];
+        if (factor == 0) continue;
+        for (int j = begin; j < end; j++) row[j] -= factor * src[j];
+      }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      const T* u = lu_.Row(i);
+      T* row = x.Row(i);
+      for (int k = i + 1; k < n; k++) {
+        const T* src = x.Row(k);
+        T factor = u[k];
+        if (factor == 0) continue;
+        for (int j = begin; j < end; j++) row[j] -= factor * src[j];
+      }
+      T scale = 1 / u[i];
+      for (int j = begin; j < end; j++) row[j] *= scale;
+    }
+  });
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
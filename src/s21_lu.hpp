@@ -0,0 +1,55 @@
+#ifndef S21_LU_HPP
+#define S21_LU_HPP
+
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+// LU factorization with partial pivoting, P * A = L * U. The matrix is
+// factored once in the constructor; determinant, inverse and solves against
+// any number of right-hand sides then reuse the factors. Matrices of at
+// least kBlockedSize rows are factored in panels of kPanel columns whose
+// trailing updates run as parallel GEMMs.
+template <typename T>
+class S21BasicLU {
+ public:
+  static constexpr int kBlockedSize = 64;
+  static constexpr int kPanel = 64;
+
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+
+  int GetSize() const;
+  // Whether a pivot is exactly zero, so that solves are impossible
+  bool IsSingular() const;
+  // 0 once a pivot is below S21BasicMatrix<T>::kEpsilon, the singularity
+  // rule of S21Matrix::Determinant
+  T Determinant() const;
+  // log |det A|, with the sign of det A (-1, 0 or 1) stored in sign; stays
+  // finite where Determinant overflows to infinity or underflows to 0.
+  // Returns -infinity and sign 0 where Determinant returns 0.
+  T LogDeterminant(int& sign) const;
+  S21BasicMatrix<T> Inverse() const;
+  // Solves A * X = B for every column of B at once.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+
+ private:
+  void Factor();
+  void FactorPanel(int first, int last);
+  void FactorBlocked();
+  void SolveInPlace(S21BasicMatrix<T>& x) const;
+
+  // L (unit diagonal, below) and U (on and above the diagonal) share lu_
+  S21BasicMatrix<T> lu_;
+  // Row i was swapped with row pivots_[i] at step i
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+};
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+
+using S21LU = S21BasicLU<double>;
+
+#endif
@@ -0,0 +1,402 @@
+#include "s21_matrix_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#include "s21_thread_pool.hpp"
+
+// Group kernels are written as plain loops over kLanes matrices and left to
+// the auto-vectorizer. On x86-64 an AVX2 clone is picked at load time on CPUs
+// that have it. FMA is deliberately not enabled: contracting a * b + c would
+// change the rounding and break the match with the scalar code.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define S21_BATCH_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define S21_BATCH_CLONES
+#endif
+
+namespace {
+
+constexpr int kLanes = S21MatrixBatch::kLanes;
+
+// Swaps rows row and pivot[l] of lane l for every lane whose pivot is in
+// (row, last], touching columns [first_col, cols) only
+inline void SwapLaneRows(double* a, int cols, int row, int last,
+                         const int* pivot, int first_col) {
+  double* top = a + (row * cols + first_col) * kLanes;
+  for (int r = row + 1; r <= last; r++) {
+    double* other = a + (r * cols + first_col) * kLanes;
+    for (int j = 0; j < (cols - first_col) * kLanes; j += kLanes) {
+      for (int l = 0; l < kLanes; l++) {
+        double x = top[j + l], y = other[j + l];
+        bool swap = pivot[l] == r;
+        top[j + l] = swap ? y : x;
+        other[j + l] = swap ? x : y;
+      }
+    }
+  }
+}
+
+// Same elimination as S21Matrix::GaussDetInPlace, run on every lane of a
+// group: the first element of a column that is not below S21Matrix::kEpsilon
+// becomes the pivot, and a lane without one has a zero determinant. Columns
+// left of the pivot are never read again, so they are not updated.
+S21_BATCH_CLONES void DeterminantGroup(double* a, int n, double* det) {
+  int sign[kLanes] = {}, error[kLanes] = {};
+
+  for (int i = 0; i < n; i++) {
+    int pivot[kLanes];
+    for (int l = 0; l < kLanes; l++) pivot[l] = n;
+    for (int r = n - 1; r >= i; r--) {
+      const double* x = a + (r * n + i) * kLanes;
+      for (int l = 0; l < kLanes; l++) {
+        pivot[l] = std::fabs(x[l]) < S21Matrix::kEpsilon ? pivot[l] : r;
+      }
+    }
+
+    int last = i;
+    for (int l = 0; l < kLanes; l++) {
+      if (pivot[l] == n) {
+        error[l] = 1;
+        pivot[l] = i;
+      } else if (pivot[l] != i) {
+        sign[l] = !sign[l];
+      }
+      last = std::max(last, pivot[l]);
+    }
+    SwapLaneRows(a, n, i, last, pivot, i);
+
+    const double* row_i = a + i * n * kLanes;
+    double divisor[kLanes];
+    for (int l = 0; l < kLanes; l++) {
+      divisor[l] = error[l] ? 1.0 : row_i[i * kLanes + l];
+    }
+    for (int k = i + 1; k < n; k++) {
+      double* row_k = a + k * n * kLanes;
+      double ratio[kLanes];
+      for (int l = 0; l < kLanes; l++) {
+        ratio[l] = row_k[i * kLanes + l] / divisor[l];
+      }
+      for (int j = i + 1; j < n; j++) {
+        for (int l = 0; l < kLanes; l++) {
+          row_k[j * kLanes + l] -= row_i[j * kLanes + l] * ratio[l];
+        }
+      }
+    }
+  }
+
+  double result[kLanes];
+  for (int l = 0; l < kLanes; l++) result[l] = 1.0;
+  for (int i = 0; i < n; i++) {
+    const double* x = a + (i * n + i) * kLanes;
+    for (int l = 0; l < kLanes; l++) result[l] *= x[l];
+  }
+  for (int l = 0; l < kLanes; l++) {
+    if (sign[l] && std::fabs(result[l]) >= S21Matrix::kEpsilon) result[l] *= -1;
+    det[l] = error[l] ? 0.0 : result[l];
+  }
+}
+
+// Gauss-Jordan elimination with partial pivoting on [a | inv], inv starts as
+// the identity. A lane is singular, like in S21LU, when one of its pivots or
+// its determinant is below S21Matrix::kEpsilon; such lanes are reported in
+// singular and zeroed.
+S21_BATCH_CLONES void InverseGroup(double* a, double* inv, int n,
+                                   int* singular) {
+  double det[kLanes];
+  int small[kLanes] = {};
+  for (int l = 0; l < kLanes; l++) det[l] = 1.0;
+
+  for (int i = 0; i < n; i++) {
+    int pivot[kLanes];
+    double best[kLanes];
+    for (int l = 0; l < kLanes; l++) {
+      pivot[l] = i;
+      best[l] = std::fabs(a[(i * n + i) * kLanes + l]);
+    }
+    for (int r = i + 1; r < n; r++) {
+      const double* x = a + (r * n + i) * kLanes;
+      for (int l = 0; l < kLanes; l++) {
+        bool larger = std::fabs(x[l]) > best[l];
+        best[l] = larger ? std::fabs(x[l]) : best[l];
+        pivot[l] = larger ? r : pivot[l];
+      }
+    }
+
+    int last = i;
+    for (int l = 0; l < kLanes; l++) {
+      if (pivot[l] != i) det[l] = -det[l];
+      last = std::max(last, pivot[l]);
+    }
+    SwapLaneRows(a, n, i, last, pivot, i);
+    SwapLaneRows(inv, n, i, last, pivot, 0);
+
+    double* a_i = a + i * n * kLanes;
+    double* inv_i = inv + i * n * kLanes;
+    double scale[kLanes];
+    for (int l = 0; l < kLanes; l++) {
+      double value = a_i[i * kLanes + l];
+      det[l] *= value;
+      small[l] |= std::fabs(value) < S21Matrix::kEpsilon;
+      scale[l] = value != 0.0 ? 1.0 / value : 0.0;
+    }
+    for (int j = i + 1; j < n; j++) {
+      for (int l = 0; l < kLanes; l++) a_i[j * kLanes + l] *= scale[l];
+    }
+    for (int j = 0; j < n; j++) {
+      for (int l = 0; l < kLanes; l++) inv_i[j * kLanes + l] *= scale[l];
+    }
+
+    for (int k = 0; k < n; k++) {
+      if (k == i) continue;
+      double* a_k = a + k * n * kLanes;
+      double* inv_k = inv + k * n * kLanes;
+      double factor[kLanes];
+      for (int l = 0; l < kLanes; l++) factor[l] = a_k[i * kLanes + l];
+      for (int j = i + 1; j < n; j++) {
+        for (int l = 0; l < kLanes; l++) {
+          a_k[j * kLanes + l] -= factor[l] * a_i[j * kLanes + l];
+        }
+      }
+      for (int j = 0; j < n; j++) {
+        for (int l = 0; l < kLanes; l++) {
+          inv_k[j * kLanes + l] -= factor[l] * inv_i[j * kLanes + l];
+        }
+      }
+    }
+  }
+
+  for (int l = 0; l < kLanes; l++) {
+    singular[l] = small[l] || std::fabs(det[l]) < S21Matrix::kEpsilon;
+  }
+  for (int j = 0; j < n * n * kLanes; j += kLanes) {
+    for (int l = 0; l < kLanes; l++) {
+      inv[j + l] = singular[l] ? 0.0 : inv[j + l];
+    }
+  }
+}
+
+// c (m x n) = a (m x k) * b (k x n) on every lane
+S21_BATCH_CLONES void MultiplyGroup(const double* a, const double* b,
+                                    double* c, int m, int n, int k) {
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double acc[kLanes] = {};
+      for (int p = 0; p < k; p++) {
+        const double* x = a + (i * k + p) * kLanes;
+        const double* y = b + (p * n + j) * kLanes;
+        for (int l = 0; l < kLanes; l++) acc[l] += x[l] * y[l];
+      }
+      std::copy(acc, acc + kLanes, c + (i * n + j) * kLanes);
+    }
+  }
+}
+
+}  // namespace
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols), data_(nullptr) {
+  if (count_ < 1 || rows_ < 1 || cols_ < 1) {
+    throw std::invalid_argument("Count, rows and columns must be > 0");
+  }
+  MemAlloc();
+}
+
+S21MatrixBatch::S21MatrixBatch(const S21MatrixBatch& other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(nullptr) {
+  MemAlloc();
+  std::copy(other.data_, other.data_ + GroupCount() * GroupSize(), data_);
+}
+
+S21MatrixBatch::S21MatrixBatch(S21MatrixBatch&& other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_) {
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.data_ = nullptr;
+}
+
+S21MatrixBatch::~S21MatrixBatch() { MemFree(); }
+
+S21MatrixBatch& S21MatrixBatch::operator=(const S21MatrixBatch& other) {
+  if (this != &other) *this = S21MatrixBatch(other);
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator=(S21MatrixBatch&& other) {
+  if (this != &other) {
+    MemFree();
+    count_ = other.count_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    data_ = other.data_;
+    other.count_ = 0;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+void S21MatrixBatch::MemAlloc() {
+  // Lanes past count_ in the last group are kept at zero and never returned
+  std::size_t size = GroupCount() * GroupSize();
+  data_ = static_cast<double*>(
+      ::operator new[](size * sizeof(double), std::align_val_t(kAlignment)));
+  std::fill(data_, data_ + size, 0.0);
+}
+
+void S21MatrixBatch::MemFree() {
+  if (data_ != nullptr) {
+    ::operator delete[](data_, std::align_val_t(kAlignment));
+  }
+  data_ = nullptr;
+}
+
+void S21MatrixBatch::SetMatrix(int index, const S21Matrix& matrix) {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::logic_error("Can't store a matrix of a different size\n");
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) *Element(index, i, j) = matrix(i, j);
+  }
+}
+
+S21Matrix S21MatrixBatch::GetMatrix(int index) const {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) result(i, j) = *Element(index, i, j);
+  }
+  return result;
+}
+
+void S21MatrixBatch::MulMatrix(const S21MatrixBatch& other) {
+  if (count_ != other.count_) {
+    throw std::logic_error(
+        "Can't multiply batches with different matrix counts\n");
+  }
+  if (cols_ != other.rows_) {
+    throw std::logic_error(
+        "Can't multiply matrices with 1st matrix's columns count not being "
+        "equal to 2nd matrix's rows count\n");
+  }
+
+  S21MatrixBatch result(count_, rows_, other.cols_);
+  S21ForEachRowBand(GroupCount(), rows_ * cols_ * other.cols_ * kLanes,
+                    [&](int first, int last) {
+                      for (int g = first; g < last; g++) {
+                        MultiplyGroup(Group(g), other.Group(g),
+                                      result.Group(g), rows_, other.cols_,
+                                      cols_);
+                      }
+                    });
+  *this = std::move(result);
+}
+
+S21MatrixBatch S21MatrixBatch::Transpose() const {
+  S21MatrixBatch result(count_, cols_, rows_);
+  S21ForEachRowBand(GroupCount(), GroupSize(), [&](int first, int last) {
+    for (int g = first; g < last; g++) {
+      const double* src = Group(g);
+      double* dst = result.Group(g);
+      for (int i = 0; i < rows_; i++) {
+        for (int j = 0; j < cols_; j++) {
+          std::copy(src + (i * cols_ + j) * kLanes,
+                    src + (i * cols_ + j + 1) * kLanes,
+                    dst + (j * rows_ + i) * kLanes);
+        }
+      }
+    }
+  });
+  return result;
+}
+
+std::vector<double> S21MatrixBatch::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+
+  std::vector<double> result(GroupCount() * kLanes);
+  S21ForEachRowBand(GroupCount(), GroupSize() * rows_, [&](int first,
+                                                           int last) {
+    std::vector<double> work(GroupSize());
+    for (int g = first; g < last; g++) {
+      if (rows_ == 1) {
+        std::copy(Group(g), Group(g) + kLanes, &result[g * kLanes]);
+      } else {
+        std::copy(Group(g), Group(g) + GroupSize(), work.begin());
+        DeterminantGroup(work.data(), rows_, &result[g * kLanes]);
+      }
+    }
+  });
+  result.resize(count_);
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix() const {
+  std::vector<bool> singular;
+  S21MatrixBatch result = InverseMatrix(singular);
+  if (std::find(singular.begin(), singular.end(), true) != singular.end()) {
+    throw std::logic_error("Can't count matrix with its determinant = 0\n");
+  }
+  return result;
+}
+
+S21MatrixBatch S21MatrixBatch::InverseMatrix(
+    std::vector<bool>& singular) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+
+  S21MatrixBatch result(count_, rows_, cols_);
+  std::vector<int> flags(GroupCount() * kLanes);
+  S21ForEachRowBand(GroupCount(), GroupSize() * rows_ * 2, [&](int first,
+                                                               int last) {
+    std::vector<double> work(GroupSize());
+    for (int g = first; g < last; g++) {
+      double* inv = result.Group(g);
+      for (int i = 0; i < rows_; i++) {
+        std::fill_n(inv + (i * rows_ + i) * kLanes, kLanes, 1.0);
+      }
+      std::copy(Group(g), Group(g) + GroupSize(), work.begin());
+      InverseGroup(work.data(), inv, rows_, &flags[g * kLanes]);
+    }
+  });
+  singular.assign(flags.begin(), flags.begin() + count_);
+  return result;
+}
+
+double& S21MatrixBatch::operator()(int index, int row, int col) {
+  if (index < 0 || index >= count_ || row < 0 || row >= rows_ || col < 0 ||
+      col >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return *Element(index, row, col);
+}
+
+double S21MatrixBatch::operator()(int index, int row, int col) const {
+  if (index < 0 || index >= count_ || row < 0 || row >= rows_ || col < 0 ||
+      col >= cols_) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return *Element(index, row, col);
+}
+
+int S21MatrixBatch::GetCount() const { return count_; }
+
+int S21MatrixBatch::GetRows() const { return rows_; }
+
+int S21MatrixBatch::GetCols() const { return cols_; }
@@ -0,0 +1,80 @@
+#ifndef S21_MATRIX_BATCH_HPP
+#define S21_MATRIX_BATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+// A batch of count independent rows x cols matrices, stored so that one
+// operation runs on many matrices at once. Matrices are grouped kLanes at a
+// time and every group is kept in structure-of-arrays order: element (i, j)
+// of all kLanes matrices of a group is contiguous, so each arithmetic step of
+// an algorithm is a single vector instruction over kLanes matrices.
+//
+// Determinant() follows the elimination S21Matrix::Determinant runs on
+// untagged matrices of fewer than S21LU::kBlockedSize rows step by step
+// (same pivot choice, same operations in the same order) and gives the same
+// result for them. Larger matrices, which S21Matrix hands to the blocked LU
+// with partial pivoting, and structure-tagged ones may differ in rounding,
+// and in which nearly singular ones count as singular. InverseMatrix()
+// pivots on the largest element of each column like S21Matrix::InverseMatrix
+// and uses the same singularity test: a pivot or a determinant below
+// S21Matrix::kEpsilon makes the matrix singular.
+class S21MatrixBatch {
+ public:
+  // Matrices processed together by one group
+  static constexpr int kLanes = 8;
+
+  S21MatrixBatch(int count, int rows, int cols);
+  S21MatrixBatch(const S21MatrixBatch& other);
+  S21MatrixBatch(S21MatrixBatch&& other);
+  ~S21MatrixBatch();
+
+  S21MatrixBatch& operator=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator=(S21MatrixBatch&& other);
+
+  // Methods
+  void SetMatrix(int index, const S21Matrix& matrix);
+  S21Matrix GetMatrix(int index) const;
+  // Multiplies every matrix by the matching matrix of other
+  void MulMatrix(const S21MatrixBatch& other);
+  S21MatrixBatch Transpose() const;
+  std::vector<double> Determinant() const;
+  // Throws if any matrix of the batch is singular
+  S21MatrixBatch InverseMatrix() const;
+  // Marks singular matrices in singular instead of throwing; their inverse
+  // is left filled with zeros
+  S21MatrixBatch InverseMatrix(std::vector<bool>& singular) const;
+
+  // Overloaded operators
+  double& operator()(int index, int row, int col);
+  double operator()(int index, int row, int col) const;
+
+  // Accessors
+  int GetCount() const;
+  int GetRows() const;
+  int GetCols() const;
+
+ private:
+  static constexpr std::size_t kAlignment = 64;
+
+  int count_, rows_, cols_;
+  double* data_;
+
+  int GroupCount() const { return (count_ + kLanes - 1) / kLanes; }
+  std::size_t GroupSize() const {
+    return static_cast<std::size_t>(rows_) * cols_ * kLanes;
+  }
+  double* Group(int group) const { return data_ + group * GroupSize(); }
+  double* Element(int index, int row, int col) const {
+    return Group(index / kLanes) +
+           (static_cast<std::size_t>(row) * cols_ + col) * kLanes +
+           index % kLanes;
+  }
+
+  void MemAlloc();
+  void MemFree();
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef S21_MATRIX_EXPR_HPP
+#define S21_MATRIX_EXPR_HPP
+
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+class S21BasicMatrix;
+
+// Base of every element-wise matrix expression. S21Matrix derives from it as
+// well, so matrices and expressions mix freely: A + B * 2.0 - C builds a tree
+// of lightweight nodes and nothing is computed until the tree is assigned to
+// an S21Matrix, which then evaluates every element in a single pass.
+//
+// Nodes refer to matrix operands, so an expression must not outlive the
+// matrices it was built from, and it reads their elements when it is
+// evaluated, not when it is built. Assign it to an S21Matrix (or call
+// Eval) instead of keeping it in an auto variable: `auto x = a + b;` sees
+// later writes to a and b and dangles once they are destroyed.
+//
+// Besides GetRows, GetCols and At(row, col), every expression names its
+// element type Scalar and implements MayAlias(target): whether evaluating it
+// may read target's elements at positions other than the one being written,
+// in which case assigning it to target goes through a temporary.
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& Self() const { return static_cast<const E&>(*this); }
+};
+
+// Base of the operator nodes below. Code written against the eager
+// operators calls matrix methods on their results, as in
+// (a + b).Determinant(), so every node offers the read-only part of the
+// S21Matrix interface by evaluating itself and forwarding the call.
+template <typename E>
+class S21MatrixNode : public S21MatrixExpr<E> {
+ public:
+  auto Eval() const { return S21BasicMatrix<typename E::Scalar>(*this); }
+
+  auto operator()(int row, int col) const {
+    const E& self = this->Self();
+    if (row >= self.GetRows() || col >= self.GetCols() || row < 0 ||
+        col < 0) {
+      throw std::out_of_range("Incorrect input, index is out of range\n");
+    }
+    return self.At(row, col);
+  }
+  template <typename M>
+  bool EqMatrix(const M& other) const {
+    return Eval().EqMatrix(other);
+  }
+  auto Transpose() const { return Eval().Transpose(); }
+  auto CalcComplements() const { return Eval().CalcComplements(); }
+  auto Determinant() const { return Eval().Determinant(); }
+  auto LogDeterminant(int& sign) const { return Eval().LogDeterminant(sign); }
+  auto InverseMatrix() const { return Eval().InverseMatrix(); }
+};
+
+// Matrices are held by reference, nested expression nodes by value
+template <typename E>
+struct S21ExprOperand {
+  using Type = const E;
+};
+
+template <typename T>
+struct S21ExprOperand<S21BasicMatrix<T>> {
+  using Type = const S21BasicMatrix<T>&;
+};
+
+struct S21SumOp {
+  template <typename A, typename B>
+  static auto Apply(A a, B b) {
+    return a + b;
+  }
+};
+
+struct S21SubOp {
+  template <typename A, typename B>
+  static auto Apply(A a, B b) {
+    return a - b;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixNode<S21MatrixBinaryExpr<L, R, Op>> {
+ public:
+  using Scalar =
+      std::common_type_t<typename L::Scalar, typename R::Scalar>;
+
+  S21MatrixBinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {}
+
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  Scalar At(int row, int col) const {
+    return Op::Apply(lhs_.At(row, col), rhs_.At(row, col));
+  }
+  template <typename M>
+  bool MayAlias(const M& target) const {
+    return lhs_.MayAlias(target) || rhs_.MayAlias(target);
+  }
+
+ private:
+  typename S21ExprOperand<L>::Type lhs_;
+  typename S21ExprOperand<R>::Type rhs_;
+};
+
+template <typename E>
+class S21MatrixScaleExpr : public S21MatrixNode<S21MatrixScaleExpr<E>> {
+ public:
+  using Scalar = typename E::Scalar;
+
+  // The factor is rounded to the operand's precision once, so float
+  // expressions are evaluated in float and long double ones keep every digit
+  S21MatrixScaleExpr(const E& operand, Scalar num)
+      : operand_(operand), num_(num) {}
+
+  int GetRows() const { return operand_.GetRows(); }
+  int GetCols() const { return operand_.GetCols(); }
+  Scalar At(int row, int col) const { return operand_.At(row, col) * num_; }
+  template <typename M>
+  bool MayAlias(const M& target) const {
+    return operand_.MayAlias(target);
+  }
+
+ private:
+  typename S21ExprOperand<E>::Type operand_;
+  Scalar num_;
+};
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21SumOp> operator+(const S21MatrixExpr<L>& lhs,
+                                              const S21MatrixExpr<R>& rhs) {
+  if (lhs.Self().GetRows() != rhs.Self().GetRows() ||
+      lhs.Self().GetCols() != rhs.Self().GetCols()) {
+    throw std::logic_error("Can't sum matrices with different sizes\n");
+  }
+  return S21MatrixBinaryExpr<L, R, S21SumOp>(lhs.Self(), rhs.Self());
+}
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21SubOp> operator-(const S21MatrixExpr<L>& lhs,
+                                              const S21MatrixExpr<R>& rhs) {
+  if (lhs.Self().GetRows() != rhs.Self().GetRows() ||
+      lhs.Self().GetCols() != rhs.Self().GetCols()) {
+    throw std::logic_error("Can't subtract matrices with different sizes\n");
+  }
+  return S21MatrixBinaryExpr<L, R, S21SubOp>(lhs.Self(), rhs.Self());
+}
+
+// As for matrices, the factor takes the operand's element type
+template <typename E>
+S21MatrixScaleExpr<E> operator*(const S21MatrixExpr<E>& expr,
+                                const typename E::Scalar num) {
+  return S21MatrixScaleExpr<E>(expr.Self(), num);
+}
+
+template <typename E>
+S21MatrixScaleExpr<E> operator*(const typename E::Scalar num,
+                                const S21MatrixExpr<E>& expr) {
+  return S21MatrixScaleExpr<E>(expr.Self(), num);
+}
+
+#endif
@@ -0,0 +1,468 @@
+#include "s21_matrix_io.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[4] = {'S', '2', '1', 'M'};
+constexpr std::uint8_t kFloat64 = 1;
+constexpr std::uint8_t kLittleEndian = 1;
+constexpr std::uint8_t kBigEndian = 2;
+constexpr std::uint32_t kDataAlignment = 64;
+
+// Text is read and written through buffers of this size
+constexpr std::size_t kChunkSize = 1 << 16;
+// Room for the longest shortest-round-trip double plus a separator
+constexpr std::size_t kMaxNumberLength = 32;
+// Row capacity of a text matrix before its first growth
+constexpr int kInitialTextRows = 64;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr std::uint8_t kHostByteOrder = kBigEndian;
+#else
+constexpr std::uint8_t kHostByteOrder = kLittleEndian;
+#endif
+
+// All multi-byte fields are in the byte order named by byte_order
+struct FileHeader {
+  char magic[4];
+  std::uint16_t version;
+  std::uint8_t dtype;
+  std::uint8_t byte_order;
+  std::uint32_t alignment;
+  std::uint32_t reserved;
+  std::int64_t rows;
+  std::int64_t cols;
+  // Distance between the starts of consecutive rows, in elements
+  std::int64_t stride;
+  std::uint64_t data_offset;
+  unsigned char padding[16];
+};
+static_assert(sizeof(FileHeader) == kDataAlignment,
+              "Header must fill exactly one aligned block");
+
+// Closes the descriptor when the scope ends, also on exceptions
+struct FileDescriptor {
+  int fd;
+  ~FileDescriptor() {
+    if (fd >= 0) close(fd);
+  }
+};
+
+void SwapBytes(std::uint16_t& value) { value = __builtin_bswap16(value); }
+void SwapBytes(std::uint32_t& value) { value = __builtin_bswap32(value); }
+void SwapBytes(std::uint64_t& value) { value = __builtin_bswap64(value); }
+void SwapBytes(std::int64_t& value) {
+  value = static_cast<std::int64_t>(
+      __builtin_bswap64(static_cast<std::uint64_t>(value)));
+}
+void SwapBytes(double& value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  bits = __builtin_bswap64(bits);
+  std::memcpy(&value, &bits, sizeof(bits));
+}
+
+std::runtime_error SystemError(const std::string& what,
+                               const std::string& path) {
+  return std::runtime_error(what + " " + path + ": " + std::strerror(errno) +
+                            "\n");
+}
+
+// Decodes and validates a header against the size of its file. On return
+// swapped tells whether elements are in the opposite byte order.
+FileHeader ParseHeader(const void* bytes, std::uint64_t file_size,
+                       bool& swapped) {
+  FileHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("Not a matrix file, wrong magic number\n");
+  }
+  if (header.byte_order != kLittleEndian && header.byte_order != kBigEndian) {
+    throw std::runtime_error("Matrix file has an unknown byte order\n");
+  }
+  swapped = header.byte_order != kHostByteOrder;
+  if (swapped) {
+    SwapBytes(header.version);
+    SwapBytes(header.alignment);
+    SwapBytes(header.rows);
+    SwapBytes(header.cols);
+    SwapBytes(header.stride);
+    SwapBytes(header.data_offset);
+  }
+
+  if (header.version < 1 || header.version > S21MatrixIO::kVersion) {
+    throw std::runtime_error("Matrix file has an unsupported version\n");
+  }
+  if (header.dtype != kFloat64) {
+    throw std::runtime_error("Matrix file has an unsupported element type\n");
+  }
+  if (header.rows < 1 || header.cols < 1 || header.rows > INT_MAX ||
+      header.cols > INT_MAX || header.stride < header.cols ||
+      header.data_offset < sizeof(FileHeader) ||
+      header.data_offset % sizeof(double) != 0 ||
+      header.data_offset > file_size) {
+    throw std::runtime_error("Matrix file has a corrupted header\n");
+  }
+  std::uint64_t available = (file_size - header.data_offset) / sizeof(double);
+  std::uint64_t stride = static_cast<std::uint64_t>(header.stride);
+  if (stride > available ||
+      static_cast<std::uint64_t>(header.rows - 1) >
+          (available - header.cols) / stride) {
+    throw std::runtime_error("Matrix file is truncated\n");
+  }
+  return header;
+}
+
+void WriteAll(int fd, const void* data, std::size_t size,
+              const std::string& path) {
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    ssize_t done = write(fd, bytes, size);
+    if (done < 0 && errno == EINTR) continue;
+    if (done <= 0) throw SystemError("Can't write", path);
+    bytes += done;
+    size -= static_cast<std::size_t>(done);
+  }
+}
+
+void ReadAll(int fd, void* data, std::size_t size, std::uint64_t offset,
+             const std::string& path) {
+  char* bytes = static_cast<char*>(data);
+  while (size > 0) {
+    ssize_t done = pread(fd, bytes, size, static_cast<off_t>(offset));
+    if (done < 0 && errno == EINTR) continue;
+    if (done < 0) throw SystemError("Can't read", path);
+    if (done == 0) throw std::runtime_error("Matrix file is truncated\n");
+    bytes += done;
+    offset += static_cast<std::uint64_t>(done);
+    size -= static_cast<std::size_t>(done);
+  }
+}
+
+std::uint64_t FileSize(int fd, const std::string& path) {
+  struct stat info;
+  if (fstat(fd, &info) != 0) throw SystemError("Can't stat", path);
+  return static_cast<std::uint64_t>(info.st_size);
+}
+
+bool IsDelimiter(char c) { return c == ',' || c == ';'; }
+
+bool IsSeparator(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || IsDelimiter(c);
+}
+
+// Parses the numbers of one line, calling sink(index, value) for each, and
+// returns how many there were. Whitespace may pad the numbers freely, but a
+// comma or semicolon only ever stands between two numbers, so an empty CSV
+// field is an error instead of shifting the columns after it.
+template <typename Sink>
+int ParseLine(const char* begin, const char* end, long line,
+              const Sink& sink) {
+  int count = 0;
+  const char* p = begin;
+  while (p < end) {
+    int delimiters = 0;
+    for (; p < end && IsSeparator(*p); p++) delimiters += IsDelimiter(*p);
+    bool number = p < end && !(count == 0 && *p == '#');
+    if (delimiters > (number && count > 0 ? 1 : 0)) {
+      throw std::runtime_error("Empty field on line " + std::to_string(line) +
+                               "\n");
+    }
+    if (!number) break;
+    // std::from_chars does not accept an explicit plus sign, and takes the
+    // minus of "+-5" as the number's own
+    if (*p == '+') {
+      p++;
+      if (p < end && *p == '-') {
+        throw std::runtime_error("Can't parse a number on line " +
+                                 std::to_string(line) + "\n");
+      }
+    }
+    double value = 0;
+    std::from_chars_result parsed = std::from_chars(p, end, value);
+    if (parsed.ec != std::errc() ||
+        (parsed.ptr < end && !IsSeparator(*parsed.ptr))) {
+      throw std::runtime_error("Can't parse a number on line " +
+                               std::to_string(line) + "\n");
+    }
+    sink(count++, value);
+    p = parsed.ptr;
+  }
+  return count;
+}
+
+}  // namespace
+
+void S21MatrixIO::Save(const S21Matrix& matrix, const std::string& path) {
+  FileHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dtype = kFloat64;
+  header.byte_order = kHostByteOrder;
+  header.alignment = kDataAlignment;
+  header.rows = matrix.rows_;
+  header.cols = matrix.cols_;
+  header.stride = matrix.stride_;
+  header.data_offset = sizeof(FileHeader);
+
+  FileDescriptor file{open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+  if (file.fd < 0) throw SystemError("Can't open", path);
+  WriteAll(file.fd, &header, sizeof(header), path);
+  // The last row's padding is not part of the buffer
+  std::size_t count =
+      static_cast<std::size_t>(matrix.rows_ - 1) * matrix.stride_ +
+      matrix.cols_;
+  WriteAll(file.fd, matrix.matrix_, count * sizeof(double), path);
+  int fd = file.fd;
+  file.fd = -1;
+  if (close(fd) != 0) throw SystemError("Can't write", path);
+}
+
+S21Matrix S21MatrixIO::Load(const std::string& path) {
+  FileDescriptor file{open(path.c_str(), O_RDONLY)};
+  if (file.fd < 0) throw SystemError("Can't open", path);
+  std::uint64_t size = FileSize(file.fd, path);
+  if (size < sizeof(FileHeader)) {
+    throw std::runtime_error("Not a matrix file, it is too short\n");
+  }
+
+  unsigned char bytes[sizeof(FileHeader)];
+  ReadAll(file.fd, bytes, sizeof(bytes), 0, path);
+  bool swapped = false;
+  FileHeader header = ParseHeader(bytes, size, swapped);
+
+  S21Matrix result(static_cast<int>(header.rows),
+                   static_cast<int>(header.cols));
+  if (header.stride == result.stride_) {
+    std::size_t count =
+        static_cast<std::size_t>(result.rows_ - 1) * result.stride_ +
+        result.cols_;
+    ReadAll(file.fd, result.matrix_, count * sizeof(double),
+            header.data_offset, path);
+  } else {
+    for (int i = 0; i < result.rows_; i++) {
+      ReadAll(file.fd, result.Row(i), result.cols_ * sizeof(double),
+              header.data_offset + i * header.stride * sizeof(double), path);
+    }
+  }
+  if (swapped) {
+    for (int i = 0; i < result.rows_; i++) {
+      double* row = result.Row(i);
+      for (int j = 0; j < result.cols_; j++) SwapBytes(row[j]);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21MatrixIO::ReadText(std::istream& in) {
+  S21Matrix result(1, 1);
+  int cols = 0;
+  long line = 0;
+
+  // Each row is parsed straight into the first spare row of result's
+  // buffer, and only counted once the whole line turned out valid
+  auto parse_line = [&](const char* begin, const char* end) {
+    line++;
+    if (cols == 0) {
+      std::vector<double> first;
+      ParseLine(begin, end, line,
+                [&](int, double value) { first.push_back(value); });
+      if (first.empty()) return;
+      cols = static_cast<int>(first.size());
+      result = S21Matrix(1, cols);
+      result.Reserve(kInitialTextRows, cols);
+      std::copy(first.begin(), first.end(), result.Row(0));
+      return;
+    }
+
+    int rows = result.rows_;
+    if (rows == result.row_capacity_) result.Reserve(2 * rows, cols);
+    double* row = result.Row(rows);
+    int count = ParseLine(begin, end, line, [&](int j, double value) {
+      if (j >= cols) {
+        throw std::runtime_error("Line " + std::to_string(line) +
+                                 " has more numbers than the first row\n");
+      }
+      row[j] = value;
+    });
+    if (count == 0) return;
+    if (count != cols) {
+      throw std::runtime_error("Line " + std::to_string(line) +
+                               " has fewer numbers than the first row\n");
+    }
+    result.rows_ = rows + 1;
+  };
+
+  std::vector<char> buffer(kChunkSize);
+  std::size_t filled = 0;
+  bool done = false;
+  while (!done) {
+    // A line longer than the buffer makes the buffer grow
+    if (filled == buffer.size()) buffer.resize(buffer.size() * 2);
+    in.read(buffer.data() + filled,
+            static_cast<std::streamsize>(buffer.size() - filled));
+    if (in.bad()) throw std::runtime_error("Can't read matrix text\n");
+    filled += static_cast<std::size_t>(in.gcount());
+    done = !in;
+
+    const char* begin = buffer.data();
+    const char* end = begin + filled;
+    while (begin < end) {
+      const char* newline =
+          static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+      if (newline == nullptr && !done) break;
+      const char* line_end = newline != nullptr ? newline : end;
+      parse_line(begin, line_end);
+      begin = newline != nullptr ? newline + 1 : end;
+    }
+    filled = end - begin;
+    std::memmove(buffer.data(), begin, filled);
+  }
+
+  if (cols == 0) throw std::runtime_error("Matrix text has no rows\n");
+  return result;
+}
+
+S21Matrix S21MatrixIO::ReadText(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) throw std::runtime_error("Can't open " + path + "\n");
+  return ReadText(in);
+}
+
+void S21MatrixIO::WriteText(const S21Matrix& matrix, std::ostream& out,
+                            char separator) {
+  std::vector<char> buffer(kChunkSize);
+  char* const limit = buffer.data() + buffer.size() - kMaxNumberLength;
+  char* p = buffer.data();
+  for (int i = 0; i < matrix.rows_; i++) {
+    const double* row = matrix.Row(i);
+    for (int j = 0; j < matrix.cols_; j++) {
+      if (p > limit) {
+        out.write(buffer.data(), p - buffer.data());
+        p = buffer.data();
+      }
+      p = std::to_chars(p, p + kMaxNumberLength - 1, row[j]).ptr;
+      *p++ = j + 1 < matrix.cols_ ? separator : '\n';
+    }
+  }
+  out.write(buffer.data(), p - buffer.data());
+  if (!out) throw std::runtime_error("Can't write matrix text\n");
+}
+
+void S21MatrixIO::WriteText(const S21Matrix& matrix, const std::string& path,
+                            char separator) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out) throw std::runtime_error("Can't open " + path + "\n");
+  WriteText(matrix, out, separator);
+  out.close();
+  if (!out) throw std::runtime_error("Can't write " + path + "\n");
+}
+
+S21MappedMatrix::S21MappedMatrix(const std::string& path)
+    : mapping_(nullptr),
+      length_(0),
+      data_(nullptr),
+      rows_(0),
+      cols_(0),
+      stride_(0) {
+  FileDescriptor file{open(path.c_str(), O_RDONLY)};
+  if (file.fd < 0) throw SystemError("Can't open", path);
+  std::uint64_t size = FileSize(file.fd, path);
+  if (size < sizeof(FileHeader)) {
+    throw std::runtime_error("Not a matrix file, it is too short\n");
+  }
+
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file.fd, 0);
+  if (mapping == MAP_FAILED) throw SystemError("Can't map", path);
+  mapping_ = mapping;
+  length_ = size;
+
+  bool swapped = false;
+  FileHeader header;
+  try {
+    header = ParseHeader(mapping, size, swapped);
+    if (swapped) {
+      throw std::runtime_error(
+          "Can't map a matrix file with a different byte order\n");
+    }
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+  data_ = reinterpret_cast<const double*>(static_cast<const char*>(mapping) +
+                                          header.data_offset);
+  rows_ = static_cast<int>(header.rows);
+  cols_ = static_cast<int>(header.cols);
+  stride_ = static_cast<std::ptrdiff_t>(header.stride);
+}
+
+S21MappedMatrix::S21MappedMatrix(S21MappedMatrix&& other)
+    : mapping_(other.mapping_),
+      length_(other.length_),
+      data_(other.data_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_) {
+  other.mapping_ = nullptr;
+  other.length_ = 0;
+  other.data_ = nullptr;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+}
+
+S21MappedMatrix::~S21MappedMatrix() { Unmap(); }
+
+S21MappedMatrix& S21MappedMatrix::operator=(S21MappedMatrix&& other) {
+  if (this != &other) {
+    Unmap();
+    mapping_ = other.mapping_;
+    length_ = other.length_;
+    data_ = other.data_;
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    stride_ = other.stride_;
+    other.mapping_ = nullptr;
+    other.length_ = 0;
+    other.data_ = nullptr;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.stride_ = 0;
+  }
+  return *this;
+}
+
+void S21MappedMatrix::Unmap() {
+  if (mapping_ != nullptr) munmap(mapping_, length_);
+  mapping_ = nullptr;
+  length_ = 0;
+}
+
+S21MatrixView S21MappedMatrix::View() const {
+  return S21MatrixView(data_, rows_, cols_, stride_);
+}
+
+double S21MappedMatrix::operator()(int row, int col) const {
+  if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return data_[row * stride_ + col];
+}
+
+int S21MappedMatrix::GetRows() const { return rows_; }
+
+int S21MappedMatrix::GetCols() const { return cols_; }
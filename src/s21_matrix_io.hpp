@@ -0,0 +1,77 @@
+#ifndef S21_MATRIX_IO_HPP
+#define S21_MATRIX_IO_HPP
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "s21_matrix_oop.hpp"
+
+// Binary matrix files. A file starts with a 64-byte header (magic "S21M",
+// format version, element type, byte order, shape and row stride) followed
+// by the elements, row after row, at a 64-byte aligned offset. Rows are
+// stored with the same stride S21Matrix uses in memory, so saving is a
+// single write of the whole buffer and loading a single read into it.
+//
+// Text files hold one matrix row per line, with numbers separated by
+// spaces, tabs, commas or semicolons, which covers CSV and whitespace
+// separated exports. Blank lines and lines starting with '#' are skipped.
+class S21MatrixIO {
+ public:
+  static constexpr int kVersion = 1;
+
+  static void Save(const S21Matrix& matrix, const std::string& path);
+  // Reads a file into a new matrix, converting the byte order if needed
+  static S21Matrix Load(const std::string& path);
+
+  // Parses the stream in fixed-size chunks and appends every row straight
+  // into the result's spare capacity, which grows geometrically. Throws
+  // std::runtime_error on malformed numbers, empty comma- or
+  // semicolon-separated fields and ragged rows.
+  static S21Matrix ReadText(std::istream& in);
+  static S21Matrix ReadText(const std::string& path);
+  // Writes numbers in their shortest round-trip form through a fixed-size
+  // buffer, so the stream sees a few large writes
+  static void WriteText(const S21Matrix& matrix, std::ostream& out,
+                        char separator = ' ');
+  static void WriteText(const S21Matrix& matrix, const std::string& path,
+                        char separator = ' ');
+};
+
+// Read-only matrix backed by a memory-mapped binary file. Nothing is read
+// until elements are touched, and pages are shared with the page cache, so
+// opening a multi-gigabyte file is immediate. View() can be used wherever a
+// matrix operand is accepted; it is valid while this object lives.
+//
+// The file must have been written in the host byte order.
+class S21MappedMatrix {
+ public:
+  explicit S21MappedMatrix(const std::string& path);
+  S21MappedMatrix(const S21MappedMatrix&) = delete;
+  S21MappedMatrix(S21MappedMatrix&& other);
+  ~S21MappedMatrix();
+
+  S21MappedMatrix& operator=(const S21MappedMatrix&) = delete;
+  S21MappedMatrix& operator=(S21MappedMatrix&& other);
+
+  S21MatrixView View() const;
+
+  // Overloaded operators
+  double operator()(int row, int col) const;
+
+  // Accessors
+  int GetRows() const;
+  int GetCols() const;
+
+ private:
+  void Unmap();
+
+  void* mapping_;
+  std::size_t length_;
+  const double* data_;
+  int rows_, cols_;
+  std::ptrdiff_t stride_;
+};
+
+#endif
@@ -1,6 +1,31 @@
 #include "s21_matrix_oop.hpp"
 
-S21Matrix::S21Matrix() : rows_(3), cols_(3), matrix_(nullptr) {
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#include "s21_gemm.hpp"
+#include "s21_lu.hpp"
+#include "s21_strassen.hpp"
+#include "s21_thread_pool.hpp"
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(3),
+      cols_(3),
+      stride_(0),
+      row_capacity_(0),
+      matrix_(nullptr),
+      allocator_(nullptr),
+      buffer_size_(0),
+      refs_(nullptr),
+      structure_(S21Structure::kGeneral),
+      lower_band_(0),
+      upper_band_(0) {
   try {
     MemAlloc();
   } catch (const std::exception& err) {
@@ -8,8 +33,19 @@ S21Matrix::S21Matrix() : rows_(3), cols_(3), matrix_(nullptr) {
   }
 }
 
-S21Matrix::S21Matrix(int rows, int cols)
-    : rows_(rows), cols_(cols), matrix_(nullptr) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      stride_(0),
+      row_capacity_(0),
+      matrix_(nullptr),
+      allocator_(nullptr),
+      buffer_size_(0),
+      refs_(nullptr),
+      structure_(S21Structure::kGeneral),
+      lower_band_(0),
+      upper_band_(0) {
   if (rows_ < 1 || cols_ < 1) {
     throw std::invalid_argument("Rows and columns must be > 0");
   }
@@ -20,48 +56,159 @@ S21Matrix::S21Matrix(int rows, int cols)
   }
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(nullptr) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(0),
+      row_capacity_(0),
+      matrix_(nullptr),
+      allocator_(nullptr),
+      buffer_size_(0),
+      refs_(nullptr),
+      structure_(other.structure_),
+      lower_band_(other.lower_band_),
+      upper_band_(other.upper_band_) {
+  if (other.refs_ != nullptr) {
+    Share(other);
+    return;
+  }
+  S21_STATS_SCOPE(S21StatsOp::kCopy, rows_, cols_, 0);
   try {
     MemAlloc();
     CopyMatrix(other);
+    structure_ = other.structure_;
   } catch (const std::exception& err) {
     std::cerr << err.what();
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      row_capacity_(other.row_capacity_),
+      matrix_(other.matrix_),
+      allocator_(other.allocator_),
+      buffer_size_(other.buffer_size_),
+      refs_(other.refs_),
+      structure_(other.structure_),
+      lower_band_(other.lower_band_),
+      upper_band_(other.upper_band_) {
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
+  other.row_capacity_ = 0;
   other.matrix_ = nullptr;
+  other.buffer_size_ = 0;
+  other.refs_ = nullptr;
 }
 
-S21Matrix::~S21Matrix() { MemFree(); }
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { MemFree(); }
 
-void S21Matrix::MemAlloc() {
+template <typename T>
+void S21BasicMatrix<T>::MemAlloc() {
   if (matrix_ != nullptr) throw std::exception();
 
-  matrix_ = new double*[rows_]();
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_]();
+  stride_ = StrideFor(cols_);
+  row_capacity_ = rows_;
+  std::size_t count = static_cast<std::size_t>(rows_) * stride_;
+  S21_STATS_SCOPE(S21StatsOp::kMemAlloc, rows_, cols_, 0, count * sizeof(T));
+  allocator_ = &S21CurrentAllocator();
+  buffer_size_ = count * sizeof(T);
+  if (S21GetCopyOnWrite() && allocator_->CanShare()) {
+    buffer_size_ += kAlignment;
+    char* block = static_cast<char*>(allocator_->Allocate(buffer_size_));
+    refs_ = new (block) std::atomic<int>(1);
+    matrix_ = reinterpret_cast<T*>(block + kAlignment);
+  } else {
+    matrix_ = static_cast<T*>(allocator_->Allocate(buffer_size_));
   }
+  std::fill(matrix_, matrix_ + count, T(0));
+}
+
+// Rows wider than a cache line are padded so that every row starts on a
+// kAlignment boundary; narrow matrices stay packed.
+template <typename T>
+int S21BasicMatrix<T>::StrideFor(int cols) {
+  const int per_line = kAlignment / sizeof(T);
+  if (cols <= per_line) return cols;
+  return (cols + per_line - 1) / per_line * per_line;
 }
 
-void S21Matrix::MemFree() {
+// Moves the elements into a new buffer with room for at least rows x cols
+// elements; the shape is unchanged. The buffer comes from the matrix's own
+// allocator, so growing a matrix inside an S21ArenaScope that was created
+// before it doesn't leave it pointing into the arena.
+template <typename T>
+void S21BasicMatrix<T>::Reallocate(int rows, int cols) {
+  S21AllocatorScope scope(allocator_ != nullptr ? *allocator_
+                                                : S21CurrentAllocator());
+  S21BasicMatrix temp(rows, cols);
   for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
-    matrix_[i] = nullptr;
+    std::copy(Row(i), Row(i) + cols_, temp.Row(i));
+  }
+  SwapBuffer(temp);
+}
+
+// Exchanges the buffers, and with them the capacities, but not the shapes
+template <typename T>
+void S21BasicMatrix<T>::SwapBuffer(S21BasicMatrix& other) {
+  std::swap(matrix_, other.matrix_);
+  std::swap(stride_, other.stride_);
+  std::swap(row_capacity_, other.row_capacity_);
+  std::swap(allocator_, other.allocator_);
+  std::swap(buffer_size_, other.buffer_size_);
+  std::swap(refs_, other.refs_);
+}
+
+// Takes another reference to other's buffer; *this must own none
+template <typename T>
+void S21BasicMatrix<T>::Share(const S21BasicMatrix& other) {
+  other.refs_->fetch_add(1, std::memory_order_relaxed);
+  matrix_ = other.matrix_;
+  stride_ = other.stride_;
+  row_capacity_ = other.row_capacity_;
+  allocator_ = other.allocator_;
+  buffer_size_ = other.buffer_size_;
+  refs_ = other.refs_;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsShared() const {
+  return refs_ != nullptr && refs_->load(std::memory_order_acquire) > 1;
+}
+
+// The copy keeps the capacities, so a detached matrix grows like the
+// original would have
+template <typename T>
+void S21BasicMatrix<T>::Detach() {
+  if (IsShared()) Reallocate(row_capacity_, stride_);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MemFree() {
+  if (refs_ != nullptr) {
+    // The last owner frees the buffer, after every other owner's accesses
+    if (refs_->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      allocator_->Deallocate(refs_, buffer_size_);
+    }
+  } else if (matrix_ != nullptr) {
+    allocator_->Deallocate(matrix_, buffer_size_);
   }
-  delete[] matrix_;
   matrix_ = nullptr;
+  buffer_size_ = 0;
+  refs_ = nullptr;
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) const {
   bool equal = true;
   for (int i = 0; equal && i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
-      if (S21Fabs(matrix_[i][j] - other.matrix_[i][j]) >= 1e-6) {
+      if (S21Fabs(Row(i)[j] - other.Row(i)[j]) >= kEpsilon) {
         equal = false;
       }
     }
@@ -69,162 +216,464 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) {
   return equal;
 }
 
-double S21Fabs(double x) {
-  if (x < 0.0) x = -x;
-  return x;
-}
-
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::logic_error("Can't sum matrices with different sizes\n");
   }
 
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] += other.matrix_[i][j];
+  PrepareWrite();
+  S21_STATS_SCOPE(S21StatsOp::kSumMatrix, rows_, cols_, 1.0 * rows_ * cols_);
+  S21ForEachRowBand(rows_, cols_, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* row = Row(i);
+      const T* src = other.Row(i);
+      for (int j = 0; j < cols_; j++) {
+        row[j] += src[j];
+      }
     }
-  }
+  });
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::logic_error("Can't subtract matrices with different sizes\n");
   }
 
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] -= other.matrix_[i][j];
+  PrepareWrite();
+  S21_STATS_SCOPE(S21StatsOp::kSubMatrix, rows_, cols_, 1.0 * rows_ * cols_);
+  S21ForEachRowBand(rows_, cols_, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* row = Row(i);
+      const T* src = other.Row(i);
+      for (int j = 0; j < cols_; j++) {
+        row[j] -= src[j];
+      }
     }
-  }
+  });
 }
 
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] *= num;
-    }
+// Scaling keeps every structure, except that a negative or zero factor
+// leaves a positive definite matrix merely symmetric
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  Detach();
+  if (structure_ == S21Structure::kPositiveDefinite && !(num > 0)) {
+    structure_ = S21Structure::kSymmetric;
   }
+  S21_STATS_SCOPE(S21StatsOp::kMulNumber, rows_, cols_, 1.0 * rows_ * cols_);
+  S21ForEachRowBand(rows_, cols_, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* row = Row(i);
+      for (int j = 0; j < cols_; j++) {
+        row[j] *= num;
+      }
+    }
+  });
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  *this = Multiply(*this, other);
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  if (cols_ != other.rows_) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<T>& other) {
+  *this = Product(View(), other);
+}
+
+// Views with an excluded row or column have no uniform stride, so they are
+// gathered into a dense copy before they reach the GEMM kernel
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Product(const S21BasicMatrixView<T>& a,
+                                             const S21BasicMatrixView<T>& b) {
+  if (a.cols_ != b.rows_) {
     throw std::logic_error(
         "Can't multiply matrices with 1st matrix's columns count not being "
         "equal to 2nd matrix's rows count\n");
   }
+  if (a.HasSkips()) return Product(S21BasicMatrix(a).View(), b);
+  if (b.HasSkips()) return Product(a, S21BasicMatrix(b).View());
 
-  S21Matrix result(rows_, other.cols_);
-  double sum;
+  S21_STATS_SCOPE(S21StatsOp::kMulMatrix, a.rows_, b.cols_,
+                  2.0 * a.rows_ * b.cols_ * a.cols_);
+  S21BasicMatrix result(a.rows_, b.cols_);
+  if constexpr (std::is_same_v<T, double>) {
+    int cutoff = S21GetStrassenCutoff();
+    if (cutoff > 0 && std::min({a.rows_, a.cols_, b.cols_}) > cutoff) {
+      S21StrassenGemm(a.rows_, b.cols_, a.cols_, a.data_, a.row_stride_,
+                      a.col_stride_, b.data_, b.row_stride_, b.col_stride_,
+                      result.matrix_, result.stride_, cutoff);
+      return result;
+    }
+  }
+  S21Gemm(a.rows_, b.cols_, a.cols_, a.data_, a.row_stride_, a.col_stride_,
+          b.data_, b.row_stride_, b.col_stride_, result.matrix_,
+          result.stride_);
+  return result;
+}
 
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      sum = 0.0;
-      for (int k = 0; k < cols_; k++) {
-        sum += matrix_[i][k] * other.matrix_[k][j];
-      }
-      result.matrix_[i][j] = sum;
+// Cache-oblivious transpose: the larger side is halved until a tile of at
+// most kTransposeTile x kTransposeTile remains, whose source rows and
+// destination rows all stay in L1 while it is copied
+template <typename T>
+void S21BasicMatrix<T>::TransposeInto(const T* src, std::ptrdiff_t row_stride,
+                                      std::ptrdiff_t col_stride, int rows,
+                                      int cols, T* dst, std::ptrdiff_t ldd) {
+  if (rows > kTransposeTile || cols > kTransposeTile) {
+    if (rows >= cols) {
+      int half = rows / 2;
+      TransposeInto(src, row_stride, col_stride, half, cols, dst, ldd);
+      TransposeInto(src + half * row_stride, row_stride, col_stride,
+                    rows - half, cols, dst + half, ldd);
+    } else {
+      int half = cols / 2;
+      TransposeInto(src, row_stride, col_stride, rows, half, dst, ldd);
+      TransposeInto(src + half * col_stride, row_stride, col_stride, rows,
+                    cols - half, dst + half * ldd, ldd);
     }
+    return;
+  }
+  for (int j = 0; j < cols; j++) {
+    T* out = dst + j * ldd;
+    const T* in = src + j * col_stride;
+    for (int i = 0; i < rows; i++) out[i] = in[i * row_stride];
   }
-  std::swap(matrix_, result.matrix_);
-  rows_ = result.rows_;
-  cols_ = result.cols_;
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
+// Symmetric matrices are their own transpose. Other structures carry over
+// with the band mirrored, so the transpose of a lower triangular matrix is
+// upper triangular.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
+  S21_STATS_SCOPE(S21StatsOp::kTranspose, rows_, cols_, 0);
+  if (IsSymmetric()) return *this;
+  S21BasicMatrix result(cols_, rows_);
+  S21ForEachRowBand(rows_, cols_, [&](int first, int last) {
+    TransposeInto(Row(first), stride_, 1, last - first, cols_,
+                  result.matrix_ + first, result.stride_);
+  });
+  if (structure_ != S21Structure::kGeneral) {
+    result.SetBandwidth(upper_band_, lower_band_);
+  }
+  return result;
+}
 
-  for (int i = 0; i < cols_; i++) {
-    for (int j = 0; j < rows_; j++) {
-      result.matrix_[i][j] = matrix_[j][i];
+// Square matrices swap mirrored tiles. Other shapes are packed to a stride
+// of cols_, permuted by following the cycles of the transposition (one bit
+// of bookkeeping per element) and spread out to the new stride; when the
+// result does not fit into the buffer a transposed copy replaces it.
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  S21_STATS_SCOPE(S21StatsOp::kTranspose, rows_, cols_, 0);
+  if (IsSymmetric()) return;
+  if (rows_ == cols_) {
+    Detach();
+    int n = rows_;
+    for (int bi = 0; bi < n; bi += kTransposeTile) {
+      int i_end = std::min(bi + kTransposeTile, n);
+      for (int bj = bi; bj < n; bj += kTransposeTile) {
+        int j_end = std::min(bj + kTransposeTile, n);
+        for (int i = bi; i < i_end; i++) {
+          for (int j = bi == bj ? i + 1 : bj; j < j_end; j++) {
+            std::swap(Row(i)[j], Row(j)[i]);
+          }
+        }
+      }
+    }
+    if (structure_ != S21Structure::kGeneral) {
+      SetBandwidth(upper_band_, lower_band_);
     }
+    return;
+  }
+
+  int new_stride = StrideFor(rows_);
+  std::size_t capacity = static_cast<std::size_t>(row_capacity_) * stride_;
+  if (static_cast<std::size_t>(cols_) * new_stride > capacity) {
+    *this = Transpose();
+    return;
+  }
+
+  Detach();
+  for (int i = 1; i < rows_; i++) {
+    std::copy(Row(i), Row(i) + cols_, matrix_ + i * cols_);
+  }
+  std::size_t last = static_cast<std::size_t>(rows_) * cols_ - 1;
+  std::vector<bool> moved(last + 1, false);
+  for (std::size_t start = 1; start < last; start++) {
+    if (moved[start]) continue;
+    // Element k of the packed rows_ x cols_ matrix goes to k * rows_ mod last
+    T value = matrix_[start];
+    std::size_t k = start;
+    do {
+      std::size_t next = k * rows_ % last;
+      std::swap(value, matrix_[next]);
+      moved[next] = true;
+      k = next;
+    } while (k != start);
+  }
+
+  std::swap(rows_, cols_);
+  stride_ = new_stride;
+  row_capacity_ = static_cast<int>(capacity / stride_);
+  for (int i = rows_ - 1; i > 0; i--) {
+    std::copy_backward(matrix_ + i * cols_, matrix_ + (i + 1) * cols_,
+                       Row(i) + cols_);
   }
-  return result;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+// With P * A * Q = L * U from complete pivoting, the adjugate is
+//   adj(A) = det(P) * det(Q) * Q * adj(U) * L^-1 * P,
+// and with U11 the leading (n - 1) x (n - 1) block of U, u the rest of its
+// last column and u_nn the last pivot,
+//   adj(U) = [u_nn * adj(U11)   -adj(U11) * u]
+//            [0                  det(U11)     ].
+// This stays valid for u_nn = 0, so matrices of rank n - 1 need no special
+// case. Complete pivoting only leaves U11 singular when the rank is below
+// n - 1, and then every cofactor is zero. The cofactor matrix is the
+// transposed adjugate; the whole computation takes O(n^3).
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
   if (rows_ != cols_) {
     throw std::logic_error("Can't count matrix with different dimensions\n");
   }
+  S21_STATS_SCOPE(S21StatsOp::kCalcComplements, rows_, cols_,
+                  10.0 / 3 * rows_ * rows_ * rows_);
 
-  S21Matrix result(rows_, cols_);
-  if (rows_ == 1) {
-    result.matrix_[0][0] = 1;
-  } else {
-    S21Matrix temp(rows_ - 1, cols_ - 1);
+  int n = rows_;
+  S21BasicMatrix result(n, n);
+  if (n == 1) {
+    result.Row(0)[0] = 1;
+    return result;
+  }
 
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        result.matrix_[i][j] = CalcMinor(temp, i, j);
-      }
+  S21BasicMatrix lu(*this);
+  std::vector<int> perm_rows, perm_cols;
+  int sign = 1;
+  if (lu.FactorCompletePivot(perm_rows, perm_cols, sign) < n - 1) {
+    return result;
+  }
+
+  // adj(U11) = det(U11) * U11^-1, inverted row by row from the bottom
+  int m = n - 1;
+  S21BasicMatrix adj_u(n, n);
+  for (int i = m - 1; i >= 0; i--) {
+    const T* u = lu.Row(i);
+    T* x = adj_u.Row(i);
+    for (int k = i + 1; k < m; k++) {
+      const T* src = adj_u.Row(k);
+      for (int j = k; j < m; j++) x[j] -= u[k] * src[j];
+    }
+    T scale = 1 / u[i];
+    for (int j = i + 1; j < m; j++) x[j] *= scale;
+    x[i] = scale;
+  }
+  T det11 = 1;
+  for (int k = 0; k < m; k++) det11 *= lu.Row(k)[k];
+  T last = lu.Row(m)[m];
+  for (int i = 0; i < m; i++) {
+    T* x = adj_u.Row(i);
+    T sum = 0;
+    for (int j = i; j < m; j++) {
+      x[j] *= det11;
+      sum += x[j] * lu.Row(j)[m];
+    }
+    x[m] = -sum;
+    for (int j = i; j < m; j++) x[j] *= last;
+  }
+  adj_u.Row(m)[m] = det11;
+
+  S21BasicMatrix l_inv(n, n);
+  for (int i = 0; i < n; i++) {
+    const T* l = lu.Row(i);
+    T* y = l_inv.Row(i);
+    y[i] = 1;
+    for (int k = 0; k < i; k++) {
+      const T* src = l_inv.Row(k);
+      if (l[k] == 0) continue;
+      for (int j = 0; j <= k; j++) y[j] -= l[k] * src[j];
     }
   }
+
+  S21BasicMatrix adj = Product(adj_u.View(), l_inv.View());
+  for (int i = 0; i < n; i++) {
+    T* row = result.Row(perm_rows[i]);
+    for (int j = 0; j < n; j++) row[perm_cols[j]] = sign * adj.Row(j)[i];
+  }
   return result;
 }
 
-double S21Matrix::CalcMinor(S21Matrix& temp, int a, int b) {
-  double det = 0;
-  int count = 0, rank = rows_ - 1;
+// Factors *this in place with complete pivoting, P * A * Q = L * U: the
+// unit lower factor ends up below the diagonal and U on and above it. Row i
+// of P * A * Q is row rows[i] of A and its column j is column cols[j] of A;
+// sign is det(P) * det(Q). Returns the rank, the number of steps taken
+// before the remaining block is all zeros.
+template <typename T>
+int S21BasicMatrix<T>::FactorCompletePivot(std::vector<int>& rows,
+                                           std::vector<int>& cols,
+                                           int& sign) {
+  int n = rows_;
+  rows.resize(n);
+  cols.resize(n);
+  std::iota(rows.begin(), rows.end(), 0);
+  std::iota(cols.begin(), cols.end(), 0);
+  sign = 1;
+  PrepareWrite();
 
-  for (int i = 0; i <= rank; i++) {
-    for (int j = 0; j <= rank; j++) {
-      if (i == a || j == b) continue;
-      temp.matrix_[count / rank][count % rank] = matrix_[i][j];
-      count++;
+  for (int k = 0; k < n; k++) {
+    int pivot_row = k, pivot_col = k;
+    T largest = 0;
+    for (int i = k; i < n; i++) {
+      const T* row = Row(i);
+      for (int j = k; j < n; j++) {
+        if (S21Fabs(row[j]) > largest) {
+          largest = S21Fabs(row[j]);
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
     }
+    if (largest == 0) return k;
+
+    if (pivot_row != k) {
+      SwapZeroPivot(*this, pivot_row, k);
+      std::swap(rows[pivot_row], rows[k]);
+      sign = -sign;
+    }
+    if (pivot_col != k) {
+      for (int i = 0; i < n; i++) std::swap(Row(i)[pivot_col], Row(i)[k]);
+      std::swap(cols[pivot_col], cols[k]);
+      sign = -sign;
+    }
+
+    const T* pivot = Row(k);
+    T scale = 1 / pivot[k];
+    S21ForEachRowBand(n - k - 1, n - k, [&](int first, int last) {
+      for (int i = k + 1 + first; i < k + 1 + last; i++) {
+        T* row = Row(i);
+        T ratio = row[k] * scale;
+        row[k] = ratio;
+        if (ratio == 0) continue;
+        for (int j = k + 1; j < n; j++) row[j] -= ratio * pivot[j];
+      }
+    });
   }
+  return n;
+}
+
+// temp is the elimination scratch: the minor is read through a view and
+// written into it once, so no allocation happens per cofactor.
+template <typename T>
+T S21BasicMatrix<T>::CalcMinor(S21BasicMatrix& temp, int a, int b) {
+  T det = 0;
 
-  det = temp.Determinant();
-  if ((a + b) % 2 && S21Fabs(det) >= 1e-6) det *= -1;
+  temp = Minor(a, b);
+  if (temp.rows_ == 1) {
+    det = temp.Row(0)[0];
+  } else {
+    temp.GaussDetInPlace(det);
+  }
+  if ((a + b) % 2 && S21Fabs(det) >= kEpsilon) det *= -1;
   return det;
 }
 
-double S21Matrix::Determinant() {
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
   if (rows_ != cols_) {
     throw std::logic_error("Can't count matrix with different dimensions\n");
   }
+  S21_STATS_SCOPE(S21StatsOp::kDeterminant, rows_, cols_,
+                  2.0 / 3 * rows_ * rows_ * rows_);
 
-  double result = 0;
+  T result = 0;
   if (rows_ == 1) {
-    result = matrix_[0][0];
-  } else {
+    result = Row(0)[0];
+  } else if (structure_ == S21Structure::kGeneral) {
     GaussDet(result);
+  } else if (lower_band_ == 0 || upper_band_ == 0) {
+    result = PivotProduct(false);
+  } else {
+    if (structure_ == S21Structure::kPositiveDefinite) {
+      S21BasicMatrix factor(*this);
+      if (factor.FactorCholesky(lower_band_)) return factor.PivotProduct(true);
+    }
+    if (2 * (lower_band_ + upper_band_) < rows_) {
+      S21BasicMatrix temp(*this);
+      result = temp.BandDetInPlace(lower_band_, upper_band_);
+    } else {
+      GaussDet(result);
+    }
   }
   return result;
 }
 
-void S21Matrix::GaussDet(double& result) {
-  S21Matrix temp(rows_, cols_);
-  temp.CopyMatrix(*this);
+template <typename T>
+T S21BasicMatrix<T>::LogDeterminant(int& sign) {
+  if (rows_ != cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+  S21_STATS_SCOPE(S21StatsOp::kDeterminant, rows_, cols_,
+                  2.0 / 3 * rows_ * rows_ * rows_);
+
+  if (structure_ != S21Structure::kGeneral &&
+      (lower_band_ == 0 || upper_band_ == 0)) {
+    return LogPivotProduct(sign, false);
+  }
+  if (structure_ == S21Structure::kPositiveDefinite) {
+    S21BasicMatrix factor(*this);
+    if (factor.FactorCholesky(lower_band_)) {
+      return factor.LogPivotProduct(sign, true);
+    }
+  }
+  return S21BasicLU<T>(*this).LogDeterminant(sign);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::GaussDet(T& result) {
+  if (rows_ >= S21BasicLU<T>::kBlockedSize) {
+    result = S21BasicLU<T>(*this).Determinant();
+    return;
+  }
+  S21BasicMatrix temp(*this);
+  temp.GaussDetInPlace(result);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::GaussDetInPlace(T& result) {
   int n = rows_, sign = 0, error = 0;
+  PrepareWrite();
 
   for (int i = 0; !error && i < n; i++) {
     int bup = i;
-    while (i < n && S21Fabs(temp.matrix_[i][bup]) < 1e-6) i++;
+    while (i < n && S21Fabs(Row(i)[bup]) < kEpsilon) i++;
     if (i == n) {
       error = 1;
     } else if (bup != i) {
-      SwapZeroPivot(temp, bup, i);
+      SwapZeroPivot(*this, bup, i);
       sign = !sign;
     }
     i = bup;
 
     for (int k = i + 1; !error && k < n; k++) {
-      double ratio = temp.matrix_[k][i] / temp.matrix_[i][i];
+      T ratio = Row(k)[i] / Row(i)[i];
       for (int j = 0; i < n - 1 && j < n; j++) {
-        temp.matrix_[k][j] -= temp.matrix_[i][j] * ratio;
+        Row(k)[j] -= Row(i)[j] * ratio;
       }
     }
   }
 
   if (!error) {
     result = 1;
-    for (int i = 0; i < rows_; i++) result *= temp.matrix_[i][i];
-    if (sign && S21Fabs(result) >= 1e-6) result *= -1;
+    for (int i = 0; i < rows_; i++) result *= Row(i)[i];
+    if (sign && S21Fabs(result) >= kEpsilon) result *= -1;
   }
 }
 
-void S21Matrix::CopyMatrix(const S21Matrix& A) {
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const S21BasicMatrix& A) {
   int rows, cols;
+  PrepareWrite();
 
   if (rows_ < A.rows_)
     rows = rows_;
@@ -237,125 +686,588 @@ void S21Matrix::CopyMatrix(const S21Matrix& A) {
     cols = A.cols_;
 
   for (int i = 0; i < rows; i++) {
-    for (int j = 0; j < cols; j++) {
-      matrix_[i][j] = A.matrix_[i][j];
-    }
+    std::copy(A.Row(i), A.Row(i) + cols, Row(i));
   }
 }
 
-void S21Matrix::SwapZeroPivot(S21Matrix& A, int i, int j) {
-  double* temp = A.matrix_[i];
-  A.matrix_[i] = A.matrix_[j];
-  A.matrix_[j] = temp;
+template <typename T>
+void S21BasicMatrix<T>::SwapZeroPivot(S21BasicMatrix& A, int i, int j) {
+  A.PrepareWrite();
+  std::swap_ranges(A.Row(i), A.Row(i) + A.cols_, A.Row(j));
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  double det = Determinant();
-  if (S21Fabs(det) < 1e-6) {
-    throw std::logic_error("Can't count matrix with its determinant = 0\n");
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  S21_STATS_SCOPE(S21StatsOp::kInverseMatrix, rows_, cols_,
+                  2.0 * rows_ * rows_ * rows_);
+  if (structure_ != S21Structure::kGeneral &&
+      (lower_band_ == 0 || upper_band_ == 0)) {
+    if (S21Fabs(PivotProduct(false)) < kEpsilon) {
+      throw std::logic_error("Can't count matrix with its determinant = 0\n");
+    }
+    if (upper_band_ == 0) return LowerInverse(*this);
+    return LowerInverse(Transpose()).Transpose();
   }
-
-  S21Matrix result(rows_, cols_);
-  if (rows_ == 1) {
-    result.matrix_[0][0] = 1.0 / matrix_[0][0];
-  } else {
-    result = CalcComplements();
-    result = result.Transpose();
-    result.MulNumber(1.0 / det);
+  if (structure_ == S21Structure::kPositiveDefinite) {
+    S21BasicMatrix factor(*this);
+    if (factor.FactorCholesky(lower_band_)) {
+      if (S21Fabs(factor.PivotProduct(true)) < kEpsilon) {
+        throw std::logic_error(
+            "Can't count matrix with its determinant = 0\n");
+      }
+      return CholeskyInverse(factor);
+    }
   }
-  return result;
-}
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  S21Matrix result(*this);
-  result.SumMatrix(other);
-  return result;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix result(*this);
-  result.SubMatrix(other);
-  return result;
+  S21BasicLU<T> lu(*this);
+  if (S21Fabs(lu.Determinant()) < kEpsilon) {
+    throw std::logic_error("Can't count matrix with its determinant = 0\n");
+  }
+  return lu.Inverse();
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
-  return result;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix& other) const {
+  return Multiply(*this, other);
 }
 
-S21Matrix S21Matrix::operator*(const double num) {
-  S21Matrix result(*this);
-  result.MulNumber(num);
-  return result;
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) const {
+  return (EqMatrix(other));
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) { return (EqMatrix(other)); }
-
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
-  S21Matrix temp(other);
-  std::swap(matrix_, temp.matrix_);
+// Like std::vector, assignment keeps the buffer whenever other fits into it,
+// unless other's buffer can simply be shared. A new buffer comes from this
+// matrix's allocator, not from the current one.
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const S21BasicMatrix& other) {
+  if (this == &other) return *this;
+  if (other.refs_ != nullptr) {
+    if (refs_ != other.refs_) {
+      MemFree();
+      Share(other);
+    }
+  } else {
+    S21_STATS_SCOPE(S21StatsOp::kCopy, other.rows_, other.cols_, 0);
+    if (!IsShared() && other.rows_ <= row_capacity_ &&
+        other.cols_ <= stride_) {
+      rows_ = other.rows_;
+      cols_ = other.cols_;
+      CopyMatrix(other);
+    } else {
+      S21AllocatorScope scope(allocator_ != nullptr ? *allocator_
+                                                    : S21CurrentAllocator());
+      S21BasicMatrix temp(other);
+      SwapBuffer(temp);
+    }
+  }
   rows_ = other.rows_;
   cols_ = other.cols_;
+  structure_ = other.structure_;
+  lower_band_ = other.lower_band_;
+  upper_band_ = other.upper_band_;
+  return *this;
+}
+
+// Steals other's buffer, unless it comes from a different allocator and
+// either fits into this matrix's buffer, which then keeps it as copy
+// assignment would, or must not outlive its allocator (an arena's). The
+// copy is then allocated from this matrix's allocator, so a matrix declared
+// before an S21ArenaScope keeps `result = a * b;` from inside the scope.
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(S21BasicMatrix&& other) {
+  if (matrix_ != nullptr && other.matrix_ != nullptr &&
+      allocator_ != other.allocator_) {
+    bool fits = !IsShared() && other.rows_ <= row_capacity_ &&
+                other.cols_ <= stride_;
+    if (fits || !other.allocator_->CanShare()) {
+      S21AllocatorScope scope(*allocator_);
+      return *this = static_cast<const S21BasicMatrix&>(other);
+    }
+  }
+  if (this != &other) {
+    MemFree();
+    rows_ = other.rows_;
+    cols_ = other.cols_;
+    stride_ = other.stride_;
+    row_capacity_ = other.row_capacity_;
+    matrix_ = other.matrix_;
+    allocator_ = other.allocator_;
+    buffer_size_ = other.buffer_size_;
+    refs_ = other.refs_;
+    structure_ = other.structure_;
+    lower_band_ = other.lower_band_;
+    upper_band_ = other.upper_band_;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.stride_ = 0;
+    other.row_capacity_ = 0;
+    other.matrix_ = nullptr;
+    other.buffer_size_ = 0;
+    other.refs_ = nullptr;
+  }
   return *this;
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(
+    const S21BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(double const number) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T number) {
   MulNumber(number);
   return *this;
 }
 
-double& S21Matrix::operator()(int row, int col) {
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int row, int col) {
   if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
     throw std::out_of_range("Incorrect input, index is out of range\n");
   }
-  return matrix_[row][col];
+  Detach();
+  return Row(row)[col];
 }
 
-int S21Matrix::GetRows() const { return rows_; }
+template <typename T>
+T S21BasicMatrix<T>::operator()(int row, int col) const {
+  if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return Row(row)[col];
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() const {
+  return S21BasicMatrixView<T>(matrix_, rows_, cols_, stride_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) const {
+  return View().Block(row, col, rows, cols);
+}
 
-void S21Matrix::SetRows(int rows) {
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Minor(int row, int col) const {
+  return View().Minor(row, col);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Transposed() const {
+  return View().Transposed();
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return rows_; }
+
+// Growth beyond the capacity at least doubles it, so appending rows one at
+// a time copies each element O(1) times on average. Shrinking only changes
+// rows_ and keeps the buffer; rows that come back into use are zeroed.
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
   if (rows == rows_) return;
 
   if (rows < 1) {
     throw std::invalid_argument("Number of rows should not be less than 1\n");
   }
+  structure_ = S21Structure::kGeneral;
 
-  S21Matrix temp(*this);
-  MemFree();
+  if (rows > row_capacity_) {
+    Reallocate(std::max(rows, 2 * row_capacity_), stride_);
+  }
+  if (rows > rows_) Detach();
+  for (int i = rows_; i < rows; i++) std::fill(Row(i), Row(i) + cols_, T(0));
   rows_ = rows;
-  MemAlloc();
-  CopyMatrix(temp);
 }
 
-int S21Matrix::GetCols() const { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return cols_; }
 
-void S21Matrix::SetCols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
   if (cols == cols_) return;
 
   if (cols < 1) {
     throw std::invalid_argument(
         "Number of columns should not be less than 1\n");
   }
+  structure_ = S21Structure::kGeneral;
 
-  S21Matrix temp(*this);
-  MemFree();
+  if (cols > stride_) {
+    Reallocate(row_capacity_, std::max(cols, 2 * stride_));
+  }
+  if (cols > cols_) {
+    Detach();
+    for (int i = 0; i < rows_; i++) {
+      std::fill(Row(i) + cols_, Row(i) + cols, T(0));
+    }
+  }
   cols_ = cols;
-  MemAlloc();
-  CopyMatrix(temp);
 }
+
+template <typename T>
+int S21BasicMatrix<T>::GetRowCapacity() const { return row_capacity_; }
+
+template <typename T>
+int S21BasicMatrix<T>::GetColCapacity() const { return stride_; }
+
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument("Rows and columns must be > 0");
+  }
+  if (rows > row_capacity_ || cols > stride_) {
+    Reallocate(std::max(rows, row_capacity_), std::max(cols, stride_));
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::ShrinkToFit() {
+  if (rows_ != row_capacity_ || StrideFor(cols_) != stride_) {
+    Reallocate(rows_, cols_);
+  }
+}
+
+// Every in-place write starts here: a shared buffer is detached and the
+// structure, which the write may break, is forgotten
+template <typename T>
+void S21BasicMatrix<T>::PrepareWrite() {
+  Detach();
+  structure_ = S21Structure::kGeneral;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsSymmetric() const {
+  return structure_ == S21Structure::kDiagonal ||
+         structure_ == S21Structure::kSymmetric ||
+         structure_ == S21Structure::kPositiveDefinite;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsNarrowBand() const {
+  return structure_ != S21Structure::kGeneral &&
+         kBandRatio * (lower_band_ + upper_band_ + 1) <= rows_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetStructure(S21Structure structure) {
+  if (structure != S21Structure::kGeneral && rows_ != cols_) {
+    throw std::logic_error(
+        "Can't declare a structure of a non-square matrix\n");
+  }
+  if (structure == S21Structure::kBanded) {
+    throw std::invalid_argument("Banded structure needs SetBandwidth\n");
+  }
+  int full = rows_ - 1;
+  bool diagonal = structure == S21Structure::kDiagonal;
+  structure_ = structure;
+  lower_band_ =
+      diagonal || structure == S21Structure::kUpperTriangular ? 0 : full;
+  upper_band_ =
+      diagonal || structure == S21Structure::kLowerTriangular ? 0 : full;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetBandwidth(int lower, int upper) {
+  if (rows_ != cols_) {
+    throw std::logic_error(
+        "Can't declare a structure of a non-square matrix\n");
+  }
+  int full = rows_ - 1;
+  if (lower < 0 || upper < 0 || lower > full || upper > full) {
+    throw std::invalid_argument(
+        "Bandwidths must be between 0 and the number of rows - 1\n");
+  }
+
+  bool symmetric = IsSymmetric() && lower == upper;
+  lower_band_ = lower;
+  upper_band_ = upper;
+  if (lower == 0 && upper == 0) {
+    structure_ = S21Structure::kDiagonal;
+  } else if (symmetric) {
+    if (structure_ == S21Structure::kDiagonal) {
+      structure_ = S21Structure::kSymmetric;
+    }
+  } else if (lower == full && upper == full) {
+    structure_ = S21Structure::kGeneral;
+  } else if (lower == 0 && upper == full) {
+    structure_ = S21Structure::kUpperTriangular;
+  } else if (upper == 0 && lower == full) {
+    structure_ = S21Structure::kLowerTriangular;
+  } else {
+    structure_ = S21Structure::kBanded;
+  }
+}
+
+template <typename T>
+S21Structure S21BasicMatrix<T>::GetStructure() const { return structure_; }
+
+template <typename T>
+int S21BasicMatrix<T>::GetLowerBandwidth() const {
+  return structure_ == S21Structure::kGeneral ? rows_ - 1 : lower_band_;
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetUpperBandwidth() const {
+  return structure_ == S21Structure::kGeneral ? cols_ - 1 : upper_band_;
+}
+
+// Each row is scanned from both ends up to the band found so far; the
+// symmetry check stops at the first mismatch, so a general matrix costs
+// little more than its first rows
+template <typename T>
+S21Structure S21BasicMatrix<T>::DetectStructure() {
+  structure_ = S21Structure::kGeneral;
+  if (rows_ != cols_) return structure_;
+
+  int n = rows_, lower = 0, upper = 0;
+  bool symmetric = true;
+  for (int i = 0; i < n; i++) {
+    const T* row = Row(i);
+    for (int j = 0; j < i - lower; j++) {
+      if (row[j] != 0) {
+        lower = i - j;
+        break;
+      }
+    }
+    for (int j = n - 1; j > i + upper; j--) {
+      if (row[j] != 0) {
+        upper = j - i;
+        break;
+      }
+    }
+    for (int j = 0; symmetric && j < i; j++) symmetric = row[j] == Row(j)[i];
+  }
+
+  if (symmetric && lower > 0) {
+    structure_ = S21Structure::kSymmetric;
+    lower_band_ = lower;
+    upper_band_ = upper;
+  } else {
+    SetBandwidth(lower, upper);
+  }
+  return structure_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Multiply(const S21BasicMatrix& a,
+                                              const S21BasicMatrix& b) {
+  if (a.cols_ == b.rows_ && (a.IsNarrowBand() || b.IsNarrowBand())) {
+    return BandProduct(a, b);
+  }
+  return Product(a.View(), b.View());
+}
+
+// Only the band of the narrower banded operand is visited: with a banded,
+// row i of the result combines the rows of b in the band of row i of a;
+// with b banded, element (i, k) of a updates the stretch of result row i
+// covered by row k of b. Both run over contiguous rows. The product of two
+// banded matrices is banded with the bandwidths added.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::BandProduct(const S21BasicMatrix& a,
+                                                 const S21BasicMatrix& b) {
+  int m = a.rows_, n = b.cols_, k = a.cols_;
+  bool left = a.IsNarrowBand() &&
+              (!b.IsNarrowBand() || a.lower_band_ + a.upper_band_ <=
+                                        b.lower_band_ + b.upper_band_);
+  S21_STATS_SCOPE(S21StatsOp::kMulMatrix, m, n,
+                  2.0 * m * (left ? n : k) *
+                      (left ? a.lower_band_ + a.upper_band_ + 1
+                            : b.lower_band_ + b.upper_band_ + 1));
+
+  S21BasicMatrix result(m, n);
+  S21ForEachRowBand(m, n, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* out = result.Row(i);
+      const T* row = a.Row(i);
+      int begin = left ? std::max(0, i - a.lower_band_) : 0;
+      int end = left ? std::min(k - 1, i + a.upper_band_) : k - 1;
+      for (int p = begin; p <= end; p++) {
+        T factor = row[p];
+        if (factor == 0) continue;
+        const T* in = b.Row(p);
+        int from = left ? 0 : std::max(0, p - b.lower_band_);
+        int to = left ? n - 1 : std::min(n - 1, p + b.upper_band_);
+        for (int j = from; j <= to; j++) out[j] += factor * in[j];
+      }
+    }
+  });
+
+  if (a.structure_ != S21Structure::kGeneral &&
+      b.structure_ != S21Structure::kGeneral) {
+    result.SetBandwidth(std::min(m - 1, a.lower_band_ + b.lower_band_),
+                        std::min(m - 1, a.upper_band_ + b.upper_band_));
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::PivotProduct(bool squared) const {
+  T result = 1;
+  for (int i = 0; i < rows_; i++) {
+    T pivot = squared ? Row(i)[i] * Row(i)[i] : Row(i)[i];
+    if (S21Fabs(pivot) < kEpsilon) return 0;
+    result *= pivot;
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::LogPivotProduct(int& sign, bool squared) const {
+  T result = 0;
+  sign = 1;
+  for (int i = 0; i < rows_; i++) {
+    T pivot = squared ? Row(i)[i] * Row(i)[i] : Row(i)[i];
+    if (S21Fabs(pivot) < kEpsilon) {
+      sign = 0;
+      return -std::numeric_limits<T>::infinity();
+    }
+    if (pivot < 0) sign = -sign;
+    result += std::log(S21Fabs(pivot));
+  }
+  return result;
+}
+
+// Overwrites the lower triangle with L from A = L * L^T, reading only the
+// lower triangle and at most band subdiagonals, which L shares with A.
+// Returns false, with a partial factor, when A is not positive definite;
+// a non-positive diagonal is caught before any work is done. Each step is
+// an outer-product update of the trailing rows, split into row bands.
+template <typename T>
+bool S21BasicMatrix<T>::FactorCholesky(int band) {
+  int n = rows_;
+  for (int i = 0; i < n; i++) {
+    if (!(Row(i)[i] > 0)) return false;
+  }
+  PrepareWrite();
+
+  std::vector<T> column(n);
+  for (int k = 0; k < n; k++) {
+    T* pivot = Row(k);
+    if (!(pivot[k] > 0)) return false;
+    T root = std::sqrt(pivot[k]);
+    pivot[k] = root;
+    int last = std::min(n - 1, k + band);
+    for (int i = k + 1; i <= last; i++) {
+      T* row = Row(i);
+      row[k] /= root;
+      column[i] = row[k];
+    }
+    S21ForEachRowBand(last - k, last - k, [&](int first, int end) {
+      for (int i = k + 1 + first; i < k + 1 + end; i++) {
+        T* row = Row(i);
+        T factor = column[i];
+        if (factor == 0) continue;
+        for (int j = k + 1; j <= i; j++) row[j] -= factor * column[j];
+      }
+    });
+  }
+  return true;
+}
+
+// Gaussian elimination with partial pivoting restricted to the band. The
+// pivot comes from the lower band of column k and a row swap widens the
+// upper band to lower + upper, so a step touches at most lower rows of
+// lower + upper elements: O(n * lower * (lower + upper)) in all.
+template <typename T>
+T S21BasicMatrix<T>::BandDetInPlace(int lower, int upper) {
+  PrepareWrite();
+  int n = rows_;
+  T result = 1;
+  for (int k = 0; k < n; k++) {
+    int last_row = std::min(n - 1, k + lower);
+    int last_col = std::min(n - 1, k + lower + upper);
+    int pivot = k;
+    for (int i = k + 1; i <= last_row; i++) {
+      if (S21Fabs(Row(i)[k]) > S21Fabs(Row(pivot)[k])) pivot = i;
+    }
+    if (S21Fabs(Row(pivot)[k]) < kEpsilon) return 0;
+    if (pivot != k) {
+      std::swap_ranges(Row(k) + k, Row(k) + last_col + 1, Row(pivot) + k);
+      result = -result;
+    }
+
+    const T* pivot_row = Row(k);
+    result *= pivot_row[k];
+    T scale = 1 / pivot_row[k];
+    for (int i = k + 1; i <= last_row; i++) {
+      T* row = Row(i);
+      T ratio = row[k] * scale;
+      if (ratio == 0) continue;
+      for (int j = k + 1; j <= last_col; j++) row[j] -= ratio * pivot_row[j];
+    }
+  }
+  return result;
+}
+
+// Inverts the lower triangle of l row by row: row i of the inverse is
+// (e_i - sum of l(i, k) * row k of the inverse) / l(i, i) over the k < i
+// in the band of l
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::LowerInverse(const S21BasicMatrix& l) {
+  int n = l.rows_, band = l.GetLowerBandwidth();
+  S21BasicMatrix result(n, n);
+  for (int i = 0; i < n; i++) {
+    const T* row = l.Row(i);
+    T* y = result.Row(i);
+    y[i] = 1;
+    for (int k = std::max(0, i - band); k < i; k++) {
+      const T* src = result.Row(k);
+      if (row[k] == 0) continue;
+      for (int j = 0; j <= k; j++) y[j] -= row[k] * src[j];
+    }
+    T scale = 1 / row[i];
+    for (int j = 0; j <= i; j++) y[j] *= scale;
+  }
+  result.SetBandwidth(band == 0 ? 0 : n - 1, 0);
+  return result;
+}
+
+// A^-1 = L^-T * L^-1. Row i of its lower triangle sums
+// L^-1(k, i) * row k of L^-1 over k >= i, which needs no other row of the
+// result, so rows are computed in parallel and mirrored afterwards.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CholeskyInverse(
+    const S21BasicMatrix& l) {
+  int n = l.rows_;
+  S21BasicMatrix l_inv = LowerInverse(l);
+  S21BasicMatrix result(n, n);
+  S21ForEachRowBand(n, n, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* x = result.Row(i);
+      for (int k = i; k < n; k++) {
+        const T* src = l_inv.Row(k);
+        T factor = src[i];
+        for (int j = 0; j <= i; j++) x[j] += factor * src[j];
+      }
+    }
+  });
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) result.Row(j)[i] = result.Row(i)[j];
+  }
+  result.SetStructure(S21Structure::kPositiveDefinite);
+  return result;
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
@@ -1,59 +1,502 @@
 #ifndef S21_MATRIX_OOP_HPP
 #define S21_MATRIX_OOP_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <iostream>
+#include <vector>
 
-double S21Fabs(double x);
+#include "s21_allocator.hpp"
+#include "s21_matrix_expr.hpp"
+#include "s21_matrix_stats.hpp"
+#include "s21_matrix_view.hpp"
+#include "s21_thread_pool.hpp"
+
+using S21Matrix = S21BasicMatrix<double>;
+
+template <typename T>
+T S21Fabs(T x) {
+  if (x < 0) x = -x;
+  return x;
+}
+
+// Tolerance under which elements compare equal in EqMatrix and pivots and
+// determinants count as zero. It follows the precision of each element type;
+// double keeps the 1e-6 it has always used.
+template <typename T>
+struct S21MatrixTraits;
+
+template <>
+struct S21MatrixTraits<float> {
+  static constexpr float kEpsilon = 1e-4f;
+};
+
+template <>
+struct S21MatrixTraits<double> {
+  static constexpr double kEpsilon = 1e-6;
+};
+
+template <>
+struct S21MatrixTraits<long double> {
+  static constexpr long double kEpsilon = 1e-12L;
+};
+
+class S21SparseMatrix;
+class S21SymmetricMatrix;
+
+// What a square matrix is known to look like, see S21Matrix::SetStructure.
+// Elements more than GetLowerBandwidth() rows below or GetUpperBandwidth()
+// columns right of the diagonal are zero; the symmetric structures may have
+// a band as well.
+enum class S21Structure {
+  kGeneral,
+  kDiagonal,
+  kLowerTriangular,
+  kUpperTriangular,
+  kBanded,
+  kSymmetric,
+  // Symmetric positive definite
+  kPositiveDefinite
+};
+
+// Dense matrix of float, double or long double elements; S21Matrix is the
+// double one. float halves the memory traffic and doubles the SIMD width of
+// products, long double keeps ill-conditioned determinants accurate. The
+// GEMM, LU and transpose kernels are shared by all three types, while
+// file I/O, sparse matrices, batches and Strassen products work on doubles.
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
+  template <typename>
+  friend class S21BasicMatrix;
+  template <typename>
+  friend class S21BasicLU;
+  friend class S21MatrixIO;
+  friend class S21SparseMatrix;
+  friend class S21SymmetricMatrix;
+  friend S21Matrix operator*(const S21Matrix& dense,
+                             const S21SparseMatrix& sparse);
+  template <typename>
+  friend class S21BasicMatrixView;
+  template <typename L, typename R, typename Op>
+  friend class S21MatrixBinaryExpr;
+  template <typename E>
+  friend class S21MatrixScaleExpr;
+  template <typename U>
+  friend S21BasicMatrix<U> operator*(const S21BasicMatrixView<U>& lhs,
+                                     const S21BasicMatrixView<U>& rhs);
+  template <typename U>
+  friend S21BasicMatrix<U> operator*(const S21BasicMatrix<U>& lhs,
+                                     const S21BasicMatrixView<U>& rhs);
+  template <typename U>
+  friend S21BasicMatrix<U> operator*(const S21BasicMatrixView<U>& lhs,
+                                     const S21BasicMatrix<U>& rhs);
+
+ public:
+  using Scalar = T;
+  static constexpr T kEpsilon = S21MatrixTraits<T>::kEpsilon;
 
-class S21Matrix {
  private:
+  // Storage is a single row-major buffer aligned to kAlignment bytes; row i
+  // starts at matrix_ + i * stride_, where stride_ >= cols_. The buffer
+  // holds row_capacity_ >= rows_ rows, so stride_ and row_capacity_ are the
+  // column and row capacities. It comes from allocator_, the thread's
+  // current allocator when it was allocated, and is buffer_size_ bytes long.
+  // Buffers allocated with copy-on-write on (see S21SetCopyOnWrite) start
+  // with a reference count refs_, kAlignment bytes before matrix_, and may
+  // be shared by several matrices; refs_ is nullptr for all others.
+  static constexpr std::size_t kAlignment = S21Allocator::kAlignment;
+
   // Attributes
-  int rows_, cols_;
-  double** matrix_;
+  int rows_, cols_, stride_, row_capacity_;
+  T* matrix_;
+  S21Allocator* allocator_;
+  std::size_t buffer_size_;
+  std::atomic<int>* refs_;
+  // Declared or detected structure; the bandwidths only mean something
+  // when it is not kGeneral
+  S21Structure structure_;
+  int lower_band_, upper_band_;
+
+  T* Row(int i) const {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  T At(int row, int col) const { return Row(row)[col]; }
+  // A matrix operand is only read at the position being written
+  template <typename M>
+  bool MayAlias(const M&) const {
+    return false;
+  }
+
+  // Side of the tiles a transpose is split into
+  static constexpr int kTransposeTile = 32;
+  // Products take the banded path when the band covers at most 1 / kBandRatio
+  // of the columns, where it beats the dense kernel despite running at a
+  // lower GFLOP/s; determinants already when it covers less than half
+  static constexpr int kBandRatio = 8;
+
+  static int StrideFor(int cols);
+  void Reallocate(int rows, int cols);
+  void SwapBuffer(S21BasicMatrix& other);
+  void Share(const S21BasicMatrix& other);
+  void PrepareWrite();
+  bool IsSymmetric() const;
+  bool IsNarrowBand() const;
+  static S21BasicMatrix Multiply(const S21BasicMatrix& a,
+                                 const S21BasicMatrix& b);
+  static S21BasicMatrix BandProduct(const S21BasicMatrix& a,
+                                    const S21BasicMatrix& b);
+  // Product of the pivots elimination meets on the diagonal, which for a
+  // Cholesky factor L (squared) are l(i, i)^2. A pivot below kEpsilon makes
+  // it 0, the rule GaussDet applies to singular matrices.
+  T PivotProduct(bool squared) const;
+  // log |PivotProduct| with its sign; -infinity and sign 0 where it is 0
+  T LogPivotProduct(int& sign, bool squared) const;
+  bool FactorCholesky(int band);
+  T BandDetInPlace(int lower, int upper);
+  static S21BasicMatrix LowerInverse(const S21BasicMatrix& l);
+  static S21BasicMatrix CholeskyInverse(const S21BasicMatrix& l);
+  static void TransposeInto(const T* src, std::ptrdiff_t row_stride,
+                            std::ptrdiff_t col_stride, int rows, int cols,
+                            T* dst, std::ptrdiff_t ldd);
+  static S21BasicMatrix Product(const S21BasicMatrixView<T>& a,
+                                const S21BasicMatrixView<T>& b);
+  void GaussDetInPlace(T& result);
+  int FactorCompletePivot(std::vector<int>& rows, std::vector<int>& cols,
+                          int& sign);
+
+  // Stores op(element, expr.At(i, j)) into every element in one pass
+  template <typename E, typename Op>
+  void Apply(const E& expr, Op op);
 
  public:
   // Constructors and a destructor
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other);
-  ~S21Matrix();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other);
+  // Also converts between element types, e.g. S21Matrix to float
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr);
+  ~S21BasicMatrix();
 
   // Methods
   void MemAlloc();
   void MemFree();
-  bool EqMatrix(const S21Matrix& other);
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double CalcMinor(S21Matrix& temp, int a, int b);
-  double Determinant();
-  void GaussDet(double& result);
-  void SwapZeroPivot(S21Matrix& A, int i, int j);
-  void CopyMatrix(const S21Matrix& A);
-  S21Matrix InverseMatrix();
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  template <typename E>
+  bool EqMatrix(const S21MatrixExpr<E>& expr) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(const S21BasicMatrixView<T>& other);
+  S21BasicMatrix Transpose();
+  void TransposeInPlace();
+  // Lazy transpose, see S21MatrixView::Transposed
+  S21BasicMatrixView<T> Transposed() const;
+  S21BasicMatrix CalcComplements();
+  T CalcMinor(S21BasicMatrix& temp, int a, int b);
+  // A pivot below kEpsilon makes the determinant 0 on every path, whether
+  // elimination picks the first usable pivot (small matrices) or the
+  // largest one (the LU of large matrices)
+  T Determinant();
+  // log |det|, with the sign of the determinant (-1, 0 or 1) stored in sign,
+  // for matrices whose determinant overflows or underflows T; -infinity and
+  // sign 0 where Determinant is 0
+  T LogDeterminant(int& sign);
+  // Matrices of at least S21BasicLU<T>::kBlockedSize rows are eliminated by
+  // the blocked, parallel LU with partial pivoting instead
+  void GaussDet(T& result);
+  void SwapZeroPivot(S21BasicMatrix& A, int i, int j);
+  void CopyMatrix(const S21BasicMatrix& A);
+  S21BasicMatrix InverseMatrix();
+  // Views onto this matrix's elements, valid until it is resized or freed
+  S21BasicMatrixView<T> View() const;
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView<T> Minor(int row, int col) const;
+  // Copy-on-write state: whether the buffer is shared with other matrices,
+  // and giving this matrix a private copy of it when it is
+  bool IsShared() const;
+  void Detach();
+  // Structure tags steer Determinant, InverseMatrix, products and Transpose
+  // to specialised kernels: O(n) diagonal operations, triangular inverses,
+  // Cholesky for matrices declared kPositiveDefinite (falling back to LU
+  // when the declaration was wrong) and banded elimination and products.
+  // Every path treats pivots below kEpsilon as zero, like the general one.
+  // A declared structure is trusted, not checked: elements outside the band
+  // are never read, and a symmetric matrix is its own transpose.
+  // In-place operations except MulNumber reset it to kGeneral. Element
+  // access through operator() can't tell reads from writes and keeps it, so
+  // declare the structure once the matrix is filled, and declare kGeneral
+  // (or call DetectStructure) after writing elements that break it. Throws
+  // std::logic_error for
+  // non-square matrices; kBanded has to be declared through SetBandwidth.
+  void SetStructure(S21Structure structure);
+  // Declares the band; symmetric structures stay symmetric when lower and
+  // upper are equal, others become diagonal, triangular or kBanded
+  void SetBandwidth(int lower, int upper);
+  S21Structure GetStructure() const;
+  int GetLowerBandwidth() const;
+  int GetUpperBandwidth() const;
+  // Declares the narrowest band and symmetry the elements have (exact zeros
+  // and exact equality) and returns the structure, which is never
+  // kPositiveDefinite. Takes one pass over the matrix.
+  S21Structure DetectStructure();
 
   // Overloaded operators
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double num);
-  bool operator==(const S21Matrix& other);
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double num);
-  double& operator()(int row, int col);
+  // operator+, operator- and operator* with a number build lazy
+  // expressions, see s21_matrix_expr.hpp
+  S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  template <typename E>
+  S21BasicMatrix operator*(const S21MatrixExpr<E>& expr) const;
+  bool operator==(const S21BasicMatrix& other) const;
+  template <typename E>
+  bool operator==(const S21MatrixExpr<E>& expr) const;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other);
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& expr);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& expr);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T num);
+  // The non-const overload keeps the structure tag (see SetStructure) but
+  // gives a matrix sharing a copy-on-write buffer its private copy first,
+  // even for a read; read shared matrices through a const reference, e.g.
+  // std::as_const(matrix)(row, col), to keep sharing
+  T& operator()(int row, int col);
+  T operator()(int row, int col) const;
 
   // Accessors and mutators
   int GetRows() const;
   void SetRows(int rows);
   int GetCols() const;
   void SetCols(int cols);
+  // Capacity management in the spirit of std::vector: SetRows and SetCols
+  // grow geometrically and shrink in place
+  int GetRowCapacity() const;
+  int GetColCapacity() const;
+  void Reserve(int rows, int cols);
+  void ShrinkToFit();
 };
 
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+using S21FloatMatrix = S21BasicMatrix<float>;
+using S21LongDoubleMatrix = S21BasicMatrix<long double>;
+
+// Expressions that read *this at other positions than the one being written
+// (a transposed view of *this, say) are evaluated into a temporary first
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrix<T>::Apply(const E& expr, Op op) {
+  PrepareWrite();
+  if (expr.MayAlias(*this)) {
+    Apply(S21BasicMatrix(expr), op);
+    return;
+  }
+  S21_STATS_SCOPE(S21StatsOp::kEvaluate, rows_, cols_, 0);
+  S21ForEachRowBand(rows_, cols_, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* row = Row(i);
+      for (int j = 0; j < cols_; j++) row[j] = op(row[j], expr.At(i, j));
+    }
+  });
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr)
+    : rows_(expr.Self().GetRows()),
+      cols_(expr.Self().GetCols()),
+      stride_(0),
+      row_capacity_(0),
+      matrix_(nullptr),
+      allocator_(nullptr),
+      buffer_size_(0),
+      refs_(nullptr),
+      structure_(S21Structure::kGeneral),
+      lower_band_(0),
+      upper_band_(0) {
+  try {
+    MemAlloc();
+    Apply(expr.Self(), [](T, T value) { return value; });
+  } catch (const std::exception& err) {
+    std::cerr << err.what();
+  }
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21MatrixExpr<E>& expr) {
+  if (rows_ != expr.Self().GetRows() || cols_ != expr.Self().GetCols()) {
+    *this = S21BasicMatrix(expr);
+  } else {
+    Apply(expr.Self(), [](T, T value) { return value; });
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E>& expr) {
+  if (rows_ != expr.Self().GetRows() || cols_ != expr.Self().GetCols()) {
+    throw std::logic_error("Can't sum matrices with different sizes\n");
+  }
+  Apply(expr.Self(), [](T element, T value) { return element + value; });
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E>& expr) {
+  if (rows_ != expr.Self().GetRows() || cols_ != expr.Self().GetCols()) {
+    throw std::logic_error("Can't subtract matrices with different sizes\n");
+  }
+  Apply(expr.Self(), [](T element, T value) { return element - value; });
+  return *this;
+}
+
+// Overloads for expiring matrices work in the operand's own buffer and hand
+// it on as the result, so (A * B) + C or X * 2.0 with a temporary X
+// allocate nothing.
+template <typename T, typename R>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs,
+                            const S21MatrixExpr<R>& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename L>
+S21BasicMatrix<T> operator+(const S21MatrixExpr<L>& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs = lhs + rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs,
+                            const S21MatrixExpr<R>& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename L>
+S21BasicMatrix<T> operator-(const S21MatrixExpr<L>& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs = lhs - rhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+// The factor has the matrix's element type, which is not deduced from it,
+// so float matrices take double factors and long double ones keep theirs
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T>&& lhs,
+                            const typename S21BasicMatrix<T>::Scalar num) {
+  lhs.MulNumber(num);
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const typename S21BasicMatrix<T>::Scalar num,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs.MulNumber(num);
+  return std::move(rhs);
+}
+
+// A matrix product needs whole rows and columns of its operands, so
+// expression operands are evaluated before the product is formed, in the
+// element type of the left operand
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21MatrixExpr<E>& expr) const {
+  return Product(View(), S21BasicMatrix(expr).View());
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& lhs,
+                            const S21BasicMatrixView<T>& rhs) {
+  return S21BasicMatrix<T>::Product(lhs, rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& lhs,
+                            const S21BasicMatrixView<T>& rhs) {
+  return S21BasicMatrix<T>::Product(lhs.View(), rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  return S21BasicMatrix<T>::Product(lhs, rhs.View());
+}
+
+template <typename L, typename R>
+S21BasicMatrix<typename L::Scalar> operator*(const S21MatrixExpr<L>& lhs,
+                                             const S21MatrixExpr<R>& rhs) {
+  S21BasicMatrix<typename L::Scalar> result(lhs);
+  result.MulMatrix(S21BasicMatrix<typename L::Scalar>(rhs));
+  return result;
+}
+
+template <typename L, typename T>
+S21BasicMatrix<T> operator*(const S21MatrixExpr<L>& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  S21BasicMatrix<T> result(lhs);
+  result.MulMatrix(rhs);
+  return result;
+}
+
+// Compares element by element straight from the expression, so checking a
+// matrix against a view or a lazy transpose copies nothing
+template <typename T>
+template <typename E>
+bool S21BasicMatrix<T>::EqMatrix(const S21MatrixExpr<E>& expr) const {
+  const E& other = expr.Self();
+  if (rows_ != other.GetRows() || cols_ != other.GetCols()) return false;
+
+  bool equal = true;
+  for (int i = 0; equal && i < rows_; i++) {
+    const T* row = Row(i);
+    for (int j = 0; j < cols_; j++) {
+      if (S21Fabs(row[j] - static_cast<T>(other.At(i, j))) >= kEpsilon) {
+        equal = false;
+      }
+    }
+  }
+  return equal;
+}
+
+template <typename T>
+template <typename E>
+bool S21BasicMatrix<T>::operator==(const S21MatrixExpr<E>& expr) const {
+  return EqMatrix(expr);
+}
+
+template <typename L, typename R>
+bool operator==(const S21MatrixExpr<L>& lhs, const S21MatrixExpr<R>& rhs) {
+  return S21BasicMatrix<typename L::Scalar>(lhs).EqMatrix(rhs);
+}
+
 #endif
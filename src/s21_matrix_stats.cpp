@@ -0,0 +1,111 @@
+#include "s21_matrix_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+
+constexpr int kOpCount = static_cast<int>(S21StatsOp::kCount);
+// Bucket b holds shapes whose larger side is in (2^(b-1), 2^b]
+constexpr int kBuckets = 32;
+
+struct Counter {
+  std::atomic<long long> calls{0};
+  std::atomic<long long> bytes{0};
+  std::atomic<long long> flops{0};
+  std::atomic<long long> nanoseconds{0};
+};
+
+Counter counters[kOpCount][kBuckets];
+
+// Read and replaced with std::atomic_load/atomic_store, so events never
+// wait on a lock and a callback may replace itself
+std::shared_ptr<const S21StatsCallback> callback;
+
+int BucketOf(int rows, int cols) {
+  unsigned size = static_cast<unsigned>(std::max({rows, cols, 1}));
+  int bucket = 0;
+  while ((1u << bucket) < size && bucket < kBuckets - 1) bucket++;
+  return bucket;
+}
+
+}  // namespace
+
+const char* S21StatsOpName(S21StatsOp op) {
+  switch (op) {
+    case S21StatsOp::kMemAlloc:
+      return "MemAlloc";
+    case S21StatsOp::kCopy:
+      return "Copy";
+    case S21StatsOp::kEvaluate:
+      return "Evaluate";
+    case S21StatsOp::kSumMatrix:
+      return "SumMatrix";
+    case S21StatsOp::kSubMatrix:
+      return "SubMatrix";
+    case S21StatsOp::kMulNumber:
+      return "MulNumber";
+    case S21StatsOp::kMulMatrix:
+      return "MulMatrix";
+    case S21StatsOp::kTranspose:
+      return "Transpose";
+    case S21StatsOp::kDeterminant:
+      return "Determinant";
+    case S21StatsOp::kCalcComplements:
+      return "CalcComplements";
+    case S21StatsOp::kInverseMatrix:
+      return "InverseMatrix";
+    default:
+      return "Unknown";
+  }
+}
+
+void S21StatsRecordEvent(const S21StatsEvent& event) {
+  Counter& counter =
+      counters[static_cast<int>(event.op)][BucketOf(event.rows, event.cols)];
+  counter.calls.fetch_add(1, std::memory_order_relaxed);
+  counter.bytes.fetch_add(static_cast<long long>(event.bytes),
+                          std::memory_order_relaxed);
+  counter.flops.fetch_add(static_cast<long long>(event.flops),
+                          std::memory_order_relaxed);
+  counter.nanoseconds.fetch_add(static_cast<long long>(event.seconds * 1e9),
+                                std::memory_order_relaxed);
+
+  std::shared_ptr<const S21StatsCallback> hook = std::atomic_load(&callback);
+  if (hook) (*hook)(event);
+}
+
+std::vector<S21StatsRecord> S21StatsSnapshot() {
+  std::vector<S21StatsRecord> records;
+  for (int op = 0; op < kOpCount; op++) {
+    for (int bucket = 0; bucket < kBuckets; bucket++) {
+      const Counter& counter = counters[op][bucket];
+      long long calls = counter.calls.load(std::memory_order_relaxed);
+      if (calls == 0) continue;
+      records.push_back(
+          {static_cast<S21StatsOp>(op), 1 << bucket, calls,
+           counter.bytes.load(std::memory_order_relaxed),
+           static_cast<double>(counter.flops.load(std::memory_order_relaxed)),
+           counter.nanoseconds.load(std::memory_order_relaxed) * 1e-9});
+    }
+  }
+  return records;
+}
+
+void S21StatsReset() {
+  for (auto& row : counters) {
+    for (Counter& counter : row) {
+      counter.calls.store(0, std::memory_order_relaxed);
+      counter.bytes.store(0, std::memory_order_relaxed);
+      counter.flops.store(0, std::memory_order_relaxed);
+      counter.nanoseconds.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void S21StatsSetCallback(S21StatsCallback hook) {
+  std::shared_ptr<const S21StatsCallback> next;
+  if (hook) next = std::make_shared<const S21StatsCallback>(std::move(hook));
+  std::atomic_store(&callback, std::move(next));
+}
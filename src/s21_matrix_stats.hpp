@@ -0,0 +1,102 @@
+#ifndef S21_MATRIX_STATS_HPP
+#define S21_MATRIX_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Optional instrumentation of matrix operations. When the library is built
+// with -DS21_MATRIX_STATS, every instrumented operation counts its calls,
+// the bytes it allocated, its floating-point operations and its wall time,
+// grouped by operation and by shape bucket, and reports each call to an
+// optional callback. Without the macro the hooks expand to nothing; the
+// functions below still exist but see no events. The macro has to be the
+// same for the library and everything including its headers.
+//
+// Times are inclusive: a product that allocates its result also shows up
+// under kMemAlloc. Every kMemAlloc event is one matrix buffer, so its call
+// count is the number of matrices and temporaries created.
+
+#ifdef S21_MATRIX_STATS
+constexpr bool kS21StatsEnabled = true;
+#else
+constexpr bool kS21StatsEnabled = false;
+#endif
+
+enum class S21StatsOp {
+  kMemAlloc,
+  kCopy,
+  kEvaluate,
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kTranspose,
+  kDeterminant,
+  kCalcComplements,
+  kInverseMatrix,
+  kCount
+};
+
+const char* S21StatsOpName(S21StatsOp op);
+
+// One instrumented call, as passed to the callback
+struct S21StatsEvent {
+  S21StatsOp op;
+  int rows, cols;
+  std::size_t bytes;
+  double flops;
+  double seconds;
+};
+
+// Totals for one operation over shapes whose larger side is in
+// (max_size / 2, max_size]
+struct S21StatsRecord {
+  S21StatsOp op;
+  int max_size;
+  long long calls;
+  long long bytes;
+  double flops;
+  double seconds;
+};
+
+// Non-empty totals ordered by operation, then by shape bucket
+std::vector<S21StatsRecord> S21StatsSnapshot();
+void S21StatsReset();
+
+// The callback runs on the thread that made the call, after the totals are
+// updated, and may itself use matrices. An empty function removes it.
+using S21StatsCallback = std::function<void(const S21StatsEvent&)>;
+void S21StatsSetCallback(S21StatsCallback callback);
+
+void S21StatsRecordEvent(const S21StatsEvent& event);
+
+// Times its own lifetime and records it as one call of op
+class S21StatsScope {
+ public:
+  S21StatsScope(S21StatsOp op, int rows, int cols, double flops,
+                std::size_t bytes = 0)
+      : event_{op, rows, cols, bytes, flops, 0.0},
+        start_(std::chrono::steady_clock::now()) {}
+  S21StatsScope(const S21StatsScope&) = delete;
+  S21StatsScope& operator=(const S21StatsScope&) = delete;
+  ~S21StatsScope() {
+    event_.seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start_)
+                         .count();
+    S21StatsRecordEvent(event_);
+  }
+
+ private:
+  S21StatsEvent event_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#ifdef S21_MATRIX_STATS
+#define S21_STATS_SCOPE(...) S21StatsScope s21_stats_scope(__VA_ARGS__)
+#else
+#define S21_STATS_SCOPE(...) static_cast<void>(0)
+#endif
+
+#endif
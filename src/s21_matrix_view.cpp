@@ -0,0 +1,128 @@
+#include "s21_matrix_view.hpp"
+
+#include <utility>
+
+#include "s21_lu.hpp"
+#include "s21_matrix_oop.hpp"
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const T* data, int rows, int cols,
+                                          std::ptrdiff_t row_stride,
+                                          std::ptrdiff_t col_stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(row_stride),
+      col_stride_(col_stride),
+      skip_row_(INT_MAX),
+      skip_col_(INT_MAX) {
+  if (rows_ < 0 || cols_ < 0) {
+    throw std::invalid_argument("Rows and columns must be >= 0");
+  }
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col, int rows,
+                                                   int cols) const {
+  if (HasSkips()) {
+    throw std::logic_error(
+        "Can't take a block of a view with an excluded row or column\n");
+  }
+  if (row < 0 || col < 0 || rows < 1 || cols < 1 || row + rows > rows_ ||
+      col + cols > cols_) {
+    throw std::out_of_range("Incorrect input, block is out of range\n");
+  }
+  return S21BasicMatrixView(data_ + row * row_stride_ + col * col_stride_, rows,
+                            cols, row_stride_, col_stride_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Minor(int row, int col) const {
+  if (HasSkips()) {
+    throw std::logic_error(
+        "Can't take a minor of a view with an excluded row or column\n");
+  }
+  if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  if (rows_ < 2 || cols_ < 2) {
+    throw std::logic_error(
+        "Can't take a minor of a matrix with a single row or column\n");
+  }
+
+  S21BasicMatrixView result(*this);
+  result.rows_--;
+  result.cols_--;
+  result.skip_row_ = row;
+  result.skip_col_ = col;
+  return result;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Transposed() const {
+  S21BasicMatrixView result(*this);
+  std::swap(result.rows_, result.cols_);
+  std::swap(result.row_stride_, result.col_stride_);
+  std::swap(result.skip_row_, result.skip_col_);
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixView<T>::Transpose() const {
+  S21_STATS_SCOPE(S21StatsOp::kTranspose, rows_, cols_, 0);
+  S21BasicMatrix<T> result(cols_, rows_);
+  if (HasSkips()) {
+    for (int i = 0; i < cols_; i++) {
+      T* row = result.Row(i);
+      for (int j = 0; j < rows_; j++) row[j] = At(j, i);
+    }
+  } else {
+    S21BasicMatrix<T>::TransposeInto(data_, row_stride_, col_stride_, rows_,
+                                     cols_, result.matrix_, result.stride_);
+  }
+  return result;
+}
+
+template <typename T>
+T S21BasicMatrixView<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+  S21_STATS_SCOPE(S21StatsOp::kDeterminant, rows_, cols_,
+                  2.0 / 3 * rows_ * rows_ * rows_);
+
+  T result = 0;
+  if (rows_ == 1) {
+    result = At(0, 0);
+  } else if (rows_ >= S21BasicLU<T>::kBlockedSize) {
+    // Large views take the blocked LU like matrices do
+    S21BasicMatrix<T>(*this).GaussDet(result);
+  } else {
+    S21BasicMatrix<T> temp(*this);
+    temp.GaussDetInPlace(result);
+  }
+  return result;
+}
+
+template <typename T>
+bool S21BasicMatrixView<T>::MayAlias(const S21BasicMatrix<T>& target) const {
+  const T* begin = target.matrix_;
+  const T* end =
+      begin + static_cast<std::ptrdiff_t>(target.row_capacity_) *
+                  target.stride_;
+  bool in_place = data_ == begin && row_stride_ == target.stride_ &&
+                  col_stride_ == 1 && !HasSkips();
+  return data_ >= begin && data_ < end && !in_place;
+}
+
+template <typename T>
+T S21BasicMatrixView<T>::operator()(int row, int col) const {
+  if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  return At(row, col);
+}
+
+template class S21BasicMatrixView<float>;
+template class S21BasicMatrixView<double>;
+template class S21BasicMatrixView<long double>;
@@ -0,0 +1,84 @@
+#ifndef S21_MATRIX_VIEW_HPP
+#define S21_MATRIX_VIEW_HPP
+
+#include <climits>
+#include <cstddef>
+
+#include "s21_matrix_expr.hpp"
+
+template <typename T>
+class S21BasicMatrix;
+
+// Read-only window onto elements owned by someone else, usually a matrix
+// (see S21Matrix::View, Block, Minor and Transposed). Element (i, j) lives
+// at data[i * row_stride + j * col_stride]; a view may additionally skip
+// one row and one column, which is how a minor is described without
+// copying.
+//
+// A view is an element-wise expression, so it can be used anywhere a matrix
+// operand is accepted by +, -, +=, -= and products. It does not own its
+// data: it is invalidated when the matrix it points into is resized,
+// reassigned to a different shape or destroyed.
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+  template <typename>
+  friend class S21BasicMatrix;
+
+ private:
+  const T* data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_, col_stride_;
+  // Index of the skipped row and column in the underlying data, or INT_MAX
+  int skip_row_, skip_col_;
+
+  bool HasSkips() const {
+    return skip_row_ != INT_MAX || skip_col_ != INT_MAX;
+  }
+
+ public:
+  using Scalar = T;
+
+  S21BasicMatrixView(const T* data, int rows, int cols,
+                     std::ptrdiff_t row_stride, std::ptrdiff_t col_stride = 1);
+
+  // Methods
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView Minor(int row, int col) const;
+  // Transposed view of the same elements, made by swapping the strides.
+  // Products hand it to the GEMM kernel as is, so A.Transposed() * B and
+  // A * B.Transposed() never copy the transposed operand.
+  S21BasicMatrixView Transposed() const;
+  // Transposed copy
+  S21BasicMatrix<T> Transpose() const;
+  T Determinant() const;
+
+  // Overloaded operators
+  T operator()(int row, int col) const;
+
+  // Unchecked element access used by expression evaluation
+  T At(int row, int col) const {
+    row += row >= skip_row_;
+    col += col >= skip_col_;
+    return data_[row * row_stride_ + col * col_stride_];
+  }
+
+  // Views onto target other than target.View() itself may read its
+  // elements out of place; matrices of another type never share storage
+  bool MayAlias(const S21BasicMatrix<T>& target) const;
+  template <typename U>
+  bool MayAlias(const S21BasicMatrix<U>&) const {
+    return false;
+  }
+
+  // Accessors
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+};
+
+extern template class S21BasicMatrixView<float>;
+extern template class S21BasicMatrixView<double>;
+extern template class S21BasicMatrixView<long double>;
+
+using S21MatrixView = S21BasicMatrixView<double>;
+
+#endif
@@ -0,0 +1,482 @@
+#include "s21_sparse_matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_thread_pool.hpp"
+
+namespace {
+
+double Dot(const std::vector<double>& x, const std::vector<double>& y) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < x.size(); i++) sum += x[i] * y[i];
+  return sum;
+}
+
+double Norm(const std::vector<double>& x) { return std::sqrt(Dot(x, x)); }
+
+int DefaultIterations(int max_iterations, int size) {
+  if (max_iterations > 0) return max_iterations;
+  return std::max(100, 2 * size);
+}
+
+// Work per row for S21ForEachRowBand, capped so that it fits into an int.
+// Past kS21ParallelElements the grain is 1 anyway, so the cap changes nothing.
+int RowWork(std::size_t work) {
+  return static_cast<int>(
+      std::min(work, static_cast<std::size_t>(kS21ParallelElements)));
+}
+
+}  // namespace
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), row_start_(), col_index_(), values_() {
+  if (rows_ < 1 || cols_ < 1) {
+    throw std::invalid_argument("Rows and columns must be > 0");
+  }
+  row_start_.assign(rows_ + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense, double tolerance)
+    : S21SparseMatrix(dense.rows_, dense.cols_) {
+  for (int i = 0; i < rows_; i++) {
+    const double* row = dense.Row(i);
+    for (int j = 0; j < cols_; j++) {
+      if (std::fabs(row[j]) > tolerance) {
+        col_index_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    row_start_[i + 1] = static_cast<int>(values_.size());
+  }
+}
+
+S21SparseMatrix S21SparseMatrix::FromTriplets(
+    int rows, int cols, const std::vector<S21SparseTriplet>& triplets) {
+  S21SparseMatrix result(rows, cols);
+  for (const S21SparseTriplet& t : triplets) {
+    if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+      throw std::out_of_range("Incorrect input, index is out of range\n");
+    }
+    result.row_start_[t.row + 1]++;
+  }
+  for (int i = 0; i < rows; i++) {
+    result.row_start_[i + 1] += result.row_start_[i];
+  }
+
+  // Bucket the entries by row, then sort each row and merge duplicates
+  std::vector<int> next(result.row_start_.begin(), result.row_start_.end() - 1);
+  std::vector<std::pair<int, double>> entries(triplets.size());
+  for (const S21SparseTriplet& t : triplets) {
+    entries[next[t.row]++] = {t.col, t.value};
+  }
+  result.col_index_.reserve(triplets.size());
+  result.values_.reserve(triplets.size());
+  int start = 0;
+  for (int i = 0; i < rows; i++) {
+    int end = result.row_start_[i + 1];
+    std::sort(entries.begin() + start, entries.begin() + end,
+              [](const std::pair<int, double>& a,
+                 const std::pair<int, double>& b) {
+                return a.first < b.first;
+              });
+    for (int k = start; k < end; k++) {
+      double value = entries[k].second;
+      while (k + 1 < end && entries[k + 1].first == entries[k].first) {
+        value += entries[++k].second;
+      }
+      if (value != 0.0) {
+        result.col_index_.push_back(entries[k].first);
+        result.values_.push_back(value);
+      }
+    }
+    start = end;
+    result.row_start_[i + 1] = static_cast<int>(result.values_.size());
+  }
+  return result;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    double* row = result.Row(i);
+    for (int k = row_start_[i]; k < row_start_[i + 1]; k++) {
+      row[col_index_[k]] = values_[k];
+    }
+  }
+  return result;
+}
+
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+
+  S21SparseMatrix difference(*this);
+  difference.SubMatrix(other);
+  for (double value : difference.values_) {
+    if (std::fabs(value) >= S21Matrix::kEpsilon) return false;
+  }
+  return true;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::logic_error("Can't sum matrices with different sizes\n");
+  }
+  AddScaled(other, 1.0);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix& other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::logic_error("Can't subtract matrices with different sizes\n");
+  }
+  AddScaled(other, -1.0);
+}
+
+void S21SparseMatrix::AddScaled(const S21SparseMatrix& other, double sign) {
+  std::vector<int> row_start(rows_ + 1, 0);
+  std::vector<int> col_index;
+  std::vector<double> values;
+  col_index.reserve(values_.size() + other.values_.size());
+  values.reserve(values_.size() + other.values_.size());
+
+  auto append = [&](int col, double value) {
+    if (value != 0.0) {
+      col_index.push_back(col);
+      values.push_back(value);
+    }
+  };
+  for (int i = 0; i < rows_; i++) {
+    int a = row_start_[i], a_end = row_start_[i + 1];
+    int b = other.row_start_[i], b_end = other.row_start_[i + 1];
+    while (a < a_end || b < b_end) {
+      if (b == b_end || (a < a_end && col_index_[a] < other.col_index_[b])) {
+        append(col_index_[a], values_[a]);
+        a++;
+      } else if (a == a_end || other.col_index_[b] < col_index_[a]) {
+        append(other.col_index_[b], sign * other.values_[b]);
+        b++;
+      } else {
+        append(col_index_[a], values_[a] + sign * other.values_[b]);
+        a++;
+        b++;
+      }
+    }
+    row_start[i + 1] = static_cast<int>(values.size());
+  }
+
+  row_start_.swap(row_start);
+  col_index_.swap(col_index);
+  values_.swap(values);
+}
+
+void S21SparseMatrix::MulNumber(const double num) {
+  if (num == 0.0) {
+    std::fill(row_start_.begin(), row_start_.end(), 0);
+    col_index_.clear();
+    values_.clear();
+  } else {
+    for (double& value : values_) value *= num;
+  }
+}
+
+// Gustavson's algorithm: row i of the product is accumulated in a dense
+// scratch row from the rows of other selected by row i of this
+void S21SparseMatrix::MulMatrix(const S21SparseMatrix& other) {
+  if (cols_ != other.rows_) {
+    throw std::logic_error(
+        "Can't multiply matrices with 1st matrix's columns count not being "
+        "equal to 2nd matrix's rows count\n");
+  }
+
+  S21SparseMatrix result(rows_, other.cols_);
+  std::vector<double> accumulator(other.cols_, 0.0);
+  std::vector<int> last_row(other.cols_, -1);
+  std::vector<int> touched;
+  for (int i = 0; i < rows_; i++) {
+    touched.clear();
+    for (int k = row_start_[i]; k < row_start_[i + 1]; k++) {
+      int row = col_index_[k];
+      double a = values_[k];
+      for (int p = other.row_start_[row]; p < other.row_start_[row + 1];
+           p++) {
+        int col = other.col_index_[p];
+        if (last_row[col] != i) {
+          last_row[col] = i;
+          accumulator[col] = 0.0;
+          touched.push_back(col);
+        }
+        accumulator[col] += a * other.values_[p];
+      }
+    }
+    std::sort(touched.begin(), touched.end());
+    for (int col : touched) {
+      if (accumulator[col] != 0.0) {
+        result.col_index_.push_back(col);
+        result.values_.push_back(accumulator[col]);
+      }
+    }
+    result.row_start_[i + 1] = static_cast<int>(result.values_.size());
+  }
+  *this = std::move(result);
+}
+
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix result(cols_, rows_);
+  for (int col : col_index_) result.row_start_[col + 1]++;
+  for (int j = 0; j < cols_; j++) {
+    result.row_start_[j + 1] += result.row_start_[j];
+  }
+
+  // Rows are visited in order, so every row of the result comes out sorted
+  result.col_index_.resize(values_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(result.row_start_.begin(), result.row_start_.end() - 1);
+  for (int i = 0; i < rows_; i++) {
+    for (int k = row_start_[i]; k < row_start_[i + 1]; k++) {
+      int position = next[col_index_[k]]++;
+      result.col_index_[position] = i;
+      result.values_[position] = values_[k];
+    }
+  }
+  return result;
+}
+
+void S21SparseMatrix::Multiply(const double* x, double* y) const {
+  int per_row = RowWork(values_.size() / rows_ + 1);
+  S21ForEachRowBand(rows_, per_row, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      double sum = 0.0;
+      for (int k = row_start_[i]; k < row_start_[i + 1]; k++) {
+        sum += values_[k] * x[col_index_[k]];
+      }
+      y[i] = sum;
+    }
+  });
+}
+
+void S21SparseMatrix::CheckRightHandSide(const S21Matrix& b) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+  if (b.rows_ != rows_) {
+    throw std::logic_error(
+        "Can't solve a system with right-hand side rows count not being "
+        "equal to matrix size\n");
+  }
+}
+
+S21Matrix S21SparseMatrix::SolveCG(const S21Matrix& b, double tolerance,
+                                   int max_iterations) const {
+  CheckRightHandSide(b);
+  int n = rows_;
+  max_iterations = DefaultIterations(max_iterations, n);
+
+  std::vector<double> inverse_diagonal(n, 1.0);
+  for (int i = 0; i < n; i++) {
+    double diagonal = (*this)(i, i);
+    if (diagonal != 0.0) inverse_diagonal[i] = 1.0 / diagonal;
+  }
+
+  S21Matrix result(n, b.cols_);
+  std::vector<double> x(n), r(n), z(n), p(n), q(n);
+  for (int c = 0; c < b.cols_; c++) {
+    for (int i = 0; i < n; i++) r[i] = b.Row(i)[c];
+    double limit = tolerance * Norm(r);
+    std::fill(x.begin(), x.end(), 0.0);
+    for (int i = 0; i < n; i++) p[i] = z[i] = inverse_diagonal[i] * r[i];
+    double rz = Dot(r, z);
+
+    bool converged = Norm(r) <= limit;
+    for (int iteration = 0; !converged && iteration < max_iterations;
+         iteration++) {
+      Multiply(p.data(), q.data());
+      double alpha = rz / Dot(p, q);
+      for (int i = 0; i < n; i++) {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+      }
+      converged = Norm(r) <= limit;
+      if (!converged) {
+        for (int i = 0; i < n; i++) z[i] = inverse_diagonal[i] * r[i];
+        double rz_next = Dot(r, z);
+        double beta = rz_next / rz;
+        rz = rz_next;
+        for (int i = 0; i < n; i++) p[i] = z[i] + beta * p[i];
+      }
+    }
+    if (!converged) {
+      throw std::runtime_error("Conjugate gradients did not converge\n");
+    }
+    for (int i = 0; i < n; i++) result.Row(i)[c] = x[i];
+  }
+  return result;
+}
+
+S21Matrix S21SparseMatrix::SolveBiCGSTAB(const S21Matrix& b,
+                                         double tolerance,
+                                         int max_iterations) const {
+  CheckRightHandSide(b);
+  int n = rows_;
+  max_iterations = DefaultIterations(max_iterations, n);
+
+  S21Matrix result(n, b.cols_);
+  std::vector<double> x(n), r(n), r_hat(n), p(n), v(n), s(n), t(n);
+  for (int c = 0; c < b.cols_; c++) {
+    for (int i = 0; i < n; i++) r[i] = b.Row(i)[c];
+    double limit = tolerance * Norm(r);
+    r_hat = r;
+    std::fill(x.begin(), x.end(), 0.0);
+    std::fill(p.begin(), p.end(), 0.0);
+    std::fill(v.begin(), v.end(), 0.0);
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+    bool converged = Norm(r) <= limit;
+    for (int iteration = 0; !converged && iteration < max_iterations;
+         iteration++) {
+      double rho_next = Dot(r_hat, r);
+      if (rho_next == 0.0 || omega == 0.0) break;
+      double beta = (rho_next / rho) * (alpha / omega);
+      rho = rho_next;
+      for (int i = 0; i < n; i++) p[i] = r[i] + beta * (p[i] - omega * v[i]);
+      Multiply(p.data(), v.data());
+      alpha = rho / Dot(r_hat, v);
+      for (int i = 0; i < n; i++) s[i] = r[i] - alpha * v[i];
+      if (Norm(s) <= limit) {
+        for (int i = 0; i < n; i++) x[i] += alpha * p[i];
+        converged = true;
+      } else {
+        Multiply(s.data(), t.data());
+        omega = Dot(t, s) / Dot(t, t);
+        for (int i = 0; i < n; i++) {
+          x[i] += alpha * p[i] + omega * s[i];
+          r[i] = s[i] - omega * t[i];
+        }
+        converged = Norm(r) <= limit;
+      }
+    }
+    if (!converged) throw std::runtime_error("BiCGSTAB did not converge\n");
+    for (int i = 0; i < n; i++) result.Row(i)[c] = x[i];
+  }
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator+(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix result(*this);
+  result.MulMatrix(other);
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(const double num) const {
+  S21SparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+// Every stored element scales one row of dense into the result
+S21Matrix S21SparseMatrix::operator*(const S21Matrix& dense) const {
+  if (cols_ != dense.rows_) {
+    throw std::logic_error(
+        "Can't multiply matrices with 1st matrix's columns count not being "
+        "equal to 2nd matrix's rows count\n");
+  }
+
+  S21Matrix result(rows_, dense.cols_);
+  int per_row = RowWork((values_.size() / rows_ + 1) *
+                        static_cast<std::size_t>(dense.cols_));
+  S21ForEachRowBand(rows_, per_row, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      double* out = result.Row(i);
+      for (int k = row_start_[i]; k < row_start_[i + 1]; k++) {
+        const double* in = dense.Row(col_index_[k]);
+        double value = values_[k];
+        for (int j = 0; j < dense.cols_; j++) out[j] += value * in[j];
+      }
+    }
+  });
+  return result;
+}
+
+S21Matrix operator*(const S21Matrix& dense, const S21SparseMatrix& sparse) {
+  if (dense.cols_ != sparse.rows_) {
+    throw std::logic_error(
+        "Can't multiply matrices with 1st matrix's columns count not being "
+        "equal to 2nd matrix's rows count\n");
+  }
+
+  S21Matrix result(dense.rows_, sparse.cols_);
+  int per_row = RowWork(sparse.values_.size() + dense.cols_);
+  S21ForEachRowBand(dense.rows_, per_row, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      const double* in = dense.Row(i);
+      double* out = result.Row(i);
+      for (int k = 0; k < dense.cols_; k++) {
+        if (in[k] == 0.0) continue;
+        for (int p = sparse.row_start_[k]; p < sparse.row_start_[k + 1];
+             p++) {
+          out[sparse.col_index_[p]] += in[k] * sparse.values_[p];
+        }
+      }
+    }
+  });
+  return result;
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix& other) const {
+  return EqMatrix(other);
+}
+
+S21SparseMatrix& S21SparseMatrix::operator+=(const S21SparseMatrix& other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator-=(const S21SparseMatrix& other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator*=(const S21SparseMatrix& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix& S21SparseMatrix::operator*=(const double num) {
+  MulNumber(num);
+  return *this;
+}
+
+double S21SparseMatrix::operator()(int row, int col) const {
+  if (row >= rows_ || col >= cols_ || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  auto begin = col_index_.begin() + row_start_[row];
+  auto end = col_index_.begin() + row_start_[row + 1];
+  auto found = std::lower_bound(begin, end, col);
+  if (found == end || *found != col) return 0.0;
+  return values_[found - col_index_.begin()];
+}
+
+int S21SparseMatrix::GetRows() const { return rows_; }
+
+int S21SparseMatrix::GetCols() const { return cols_; }
+
+int S21SparseMatrix::GetNonZeros() const {
+  return static_cast<int>(values_.size());
+}
@@ -0,0 +1,86 @@
+#ifndef S21_SPARSE_MATRIX_HPP
+#define S21_SPARSE_MATRIX_HPP
+
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+// One (row, col, value) entry used to assemble a sparse matrix
+struct S21SparseTriplet {
+  int row, col;
+  double value;
+};
+
+// Sparse matrix in compressed sparse row (CSR) form: the column indices and
+// values of row i are col_index_[k] and values_[k] for k in
+// [row_start_[i], row_start_[i + 1]), sorted by column. Only non-zero
+// elements are stored, so memory and the cost of every operation scale with
+// the number of non-zeros instead of rows * cols.
+//
+// The compressed sparse column (CSC) form of a matrix is the CSR form of its
+// transpose, so Transpose() doubles as the CSR <-> CSC conversion.
+class S21SparseMatrix {
+ public:
+  S21SparseMatrix(int rows, int cols);
+  // Keeps the elements of dense whose magnitude is above tolerance
+  explicit S21SparseMatrix(const S21Matrix& dense, double tolerance = 0.0);
+  // Entries may come in any order; duplicates are summed
+  static S21SparseMatrix FromTriplets(
+      int rows, int cols, const std::vector<S21SparseTriplet>& triplets);
+
+  // Methods
+  S21Matrix ToDense() const;
+  bool EqMatrix(const S21SparseMatrix& other) const;
+  void SumMatrix(const S21SparseMatrix& other);
+  void SubMatrix(const S21SparseMatrix& other);
+  void MulNumber(const double num);
+  void MulMatrix(const S21SparseMatrix& other);
+  S21SparseMatrix Transpose() const;
+
+  // Iterative solvers for A * X = B, one column of B at a time. They stop
+  // once the residual norm drops below tolerance times the norm of the
+  // right-hand side and throw std::runtime_error when max_iterations (by
+  // default twice the size, at least 100) are not enough.
+  //
+  // Conjugate gradients with a Jacobi preconditioner, for symmetric
+  // positive definite matrices
+  S21Matrix SolveCG(const S21Matrix& b, double tolerance = 1e-10,
+                    int max_iterations = 0) const;
+  // BiCGSTAB, for general non-singular matrices
+  S21Matrix SolveBiCGSTAB(const S21Matrix& b, double tolerance = 1e-10,
+                          int max_iterations = 0) const;
+
+  // Overloaded operators
+  S21SparseMatrix operator+(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator*(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator*(const double num) const;
+  S21Matrix operator*(const S21Matrix& dense) const;
+  friend S21Matrix operator*(const S21Matrix& dense,
+                             const S21SparseMatrix& sparse);
+  bool operator==(const S21SparseMatrix& other) const;
+  S21SparseMatrix& operator+=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator-=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator*=(const S21SparseMatrix& other);
+  S21SparseMatrix& operator*=(const double num);
+  double operator()(int row, int col) const;
+
+  // Accessors
+  int GetRows() const;
+  int GetCols() const;
+  int GetNonZeros() const;
+
+ private:
+  int rows_, cols_;
+  std::vector<int> row_start_;
+  std::vector<int> col_index_;
+  std::vector<double> values_;
+
+  // this = this + sign * other, merging the sorted rows
+  void AddScaled(const S21SparseMatrix& other, double sign);
+  // y = A * x for vectors of cols_ and rows_ elements
+  void Multiply(const double* x, double* y) const;
+  void CheckRightHandSide(const S21Matrix& b) const;
+};
+
+#endif
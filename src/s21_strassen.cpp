@@ -0,0 +1,135 @@
+#include "s21_strassen.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_gemm.hpp"
+
+namespace {
+
+std::atomic<int> strassen_cutoff{0};
+
+// Operand addressed like S21Gemm's: element (i, j) is data[i * rs + j * cs]
+struct Strided {
+  const double* data;
+  std::ptrdiff_t rs, cs;
+
+  Strided At(int row, int col) const {
+    return {data + row * rs + col * cs, rs, cs};
+  }
+};
+
+// c = a + sign * b over rows x cols elements; c may be a or b
+void Add(int rows, int cols, Strided a, Strided b, double sign, double* c,
+         std::ptrdiff_t ldc) {
+  for (int i = 0; i < rows; i++) {
+    const double* x = a.data + i * a.rs;
+    const double* y = b.data + i * b.rs;
+    double* z = c + i * ldc;
+    for (int j = 0; j < cols; j++) z[j] = x[j * a.cs] + sign * y[j * b.cs];
+  }
+}
+
+bool IsBaseCase(int m, int n, int k, int cutoff) {
+  return std::min({m, n, k}) <= std::max(cutoff, 1);
+}
+
+std::size_t WorkspaceSize(int m, int n, int k, int cutoff) {
+  if (IsBaseCase(m, n, k, cutoff)) return 0;
+  std::size_t m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  return m2 * std::max(k2, n2) + k2 * n2 +
+         WorkspaceSize(m / 2, n / 2, k / 2, cutoff);
+}
+
+// One level of Winograd's variant, in the operation order of Douglas et
+// al. that needs only two temporaries, X and Y; the quadrants of C hold the
+// other intermediate products
+void Winograd(int m, int n, int k, Strided a, Strided b, double* c,
+              std::ptrdiff_t ldc, double* work, int cutoff) {
+  if (IsBaseCase(m, n, k, cutoff)) {
+    S21Gemm(m, n, k, a.data, a.rs, a.cs, b.data, b.rs, b.cs, c, ldc);
+    return;
+  }
+
+  int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  Strided a11 = a, a12 = a.At(0, k2), a21 = a.At(m2, 0), a22 = a.At(m2, k2);
+  Strided b11 = b, b12 = b.At(0, n2), b21 = b.At(k2, 0), b22 = b.At(k2, n2);
+  double* c11 = c;
+  double* c12 = c + n2;
+  double* c21 = c + m2 * ldc;
+  double* c22 = c21 + n2;
+  Strided c11s{c11, ldc, 1}, c12s{c12, ldc, 1};
+  Strided c21s{c21, ldc, 1}, c22s{c22, ldc, 1};
+
+  double* x = work;
+  double* y = x + static_cast<std::size_t>(m2) * std::max(k2, n2);
+  double* next = y + static_cast<std::size_t>(k2) * n2;
+  Strided xs{x, k2, 1}, xp{x, n2, 1}, ys{y, n2, 1};
+
+  Add(m2, k2, a11, a21, -1.0, x, k2);  // S3
+  Add(k2, n2, b22, b12, -1.0, y, n2);  // T3
+  Winograd(m2, n2, k2, xs, ys, c21, ldc, next, cutoff);  // P7
+  Add(m2, k2, a21, a22, 1.0, x, k2);   // S1
+  Add(k2, n2, b12, b11, -1.0, y, n2);  // T1
+  Winograd(m2, n2, k2, xs, ys, c22, ldc, next, cutoff);  // P5
+  Add(m2, k2, xs, a11, -1.0, x, k2);   // S2 = S1 - A11
+  Add(k2, n2, b22, ys, -1.0, y, n2);   // T2 = B22 - T1
+  Winograd(m2, n2, k2, xs, ys, c12, ldc, next, cutoff);  // P6
+  Add(m2, k2, a12, xs, -1.0, x, k2);   // S4 = A12 - S2
+  Winograd(m2, n2, k2, xs, b22, c11, ldc, next, cutoff);  // P3
+  Winograd(m2, n2, k2, a11, b11, x, n2, next, cutoff);    // P1
+  Add(m2, n2, xp, c12s, 1.0, c12, ldc);    // U2 = P1 + P6
+  Add(m2, n2, c12s, c21s, 1.0, c21, ldc);  // U3 = U2 + P7
+  Add(m2, n2, c12s, c22s, 1.0, c12, ldc);  // U4 = U2 + P5
+  Add(m2, n2, c21s, c22s, 1.0, c22, ldc);  // C22 = U3 + P5
+  Add(m2, n2, c12s, c11s, 1.0, c12, ldc);  // C12 = U4 + P3
+  Add(k2, n2, ys, b21, -1.0, y, n2);       // T4 = T2 - B21
+  Winograd(m2, n2, k2, a22, ys, c11, ldc, next, cutoff);  // P4
+  Add(m2, n2, c21s, c11s, -1.0, c21, ldc);  // C21 = U3 - P4
+  Winograd(m2, n2, k2, a12, b21, c11, ldc, next, cutoff);  // P2
+  Add(m2, n2, xp, c11s, 1.0, c11, ldc);     // C11 = P1 + P2
+
+  // Odd dimensions: the recursion covered the even-sized leading part
+  int m_even = 2 * m2, n_even = 2 * n2;
+  if (k % 2 != 0) {
+    Strided a_col = a.At(0, k - 1), b_row = b.At(k - 1, 0);
+    for (int i = 0; i < m_even; i++) {
+      double value = a_col.data[i * a_col.rs];
+      double* row = c + i * ldc;
+      for (int j = 0; j < n_even; j++) row[j] += value * b_row.data[j * b.cs];
+    }
+  }
+  if (n % 2 != 0) {
+    Strided b_col = b.At(0, n - 1);
+    S21Gemm(m, 1, k, a.data, a.rs, a.cs, b_col.data, b_col.rs, b_col.cs,
+            c + n - 1, ldc);
+  }
+  if (m % 2 != 0) {
+    Strided a_row = a.At(m - 1, 0);
+    S21Gemm(1, n_even, k, a_row.data, a_row.rs, a_row.cs, b.data, b.rs, b.cs,
+            c + (m - 1) * ldc, ldc);
+  }
+}
+
+}  // namespace
+
+void S21StrassenGemm(int m, int n, int k, const double* a, std::ptrdiff_t rsa,
+                     std::ptrdiff_t csa, const double* b, std::ptrdiff_t rsb,
+                     std::ptrdiff_t csb, double* c, std::ptrdiff_t ldc,
+                     int cutoff) {
+  if (m <= 0 || n <= 0) return;
+  std::vector<double> work(WorkspaceSize(m, n, k, cutoff));
+  Winograd(m, n, k, {a, rsa, csa}, {b, rsb, csb}, c, ldc, work.data(),
+           cutoff);
+}
+
+void S21SetStrassenCutoff(int cutoff) {
+  if (cutoff < 0) {
+    throw std::invalid_argument("Strassen cutoff must be >= 0\n");
+  }
+  strassen_cutoff.store(cutoff);
+}
+
+int S21GetStrassenCutoff() { return strassen_cutoff.load(); }
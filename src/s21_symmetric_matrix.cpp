@@ -0,0 +1,210 @@
+#include "s21_symmetric_matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_thread_pool.hpp"
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size), values_() {
+  if (size_ < 1) {
+    throw std::invalid_argument("Rows and columns must be > 0");
+  }
+  values_.assign(static_cast<std::size_t>(size_) * (size_ + 1) / 2, 0.0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix& dense)
+    : S21SymmetricMatrix(dense.rows_) {
+  if (dense.rows_ != dense.cols_) {
+    throw std::logic_error("Can't count matrix with different dimensions\n");
+  }
+  for (int i = 0; i < size_; i++) {
+    const double* row = dense.Row(i);
+    std::copy(row, row + i + 1, Row(i));
+  }
+}
+
+S21Matrix S21SymmetricMatrix::ToDense() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    const double* row = Row(i);
+    for (int j = 0; j <= i; j++) {
+      result.Row(i)[j] = row[j];
+      result.Row(j)[i] = row[j];
+    }
+  }
+  result.SetStructure(S21Structure::kSymmetric);
+  return result;
+}
+
+// The Cholesky factorization has just failed, so the dense fallbacks are
+// not told to try it again
+S21Matrix S21SymmetricMatrix::GeneralDense() const {
+  S21Matrix result = ToDense();
+  result.SetStructure(S21Structure::kGeneral);
+  return result;
+}
+
+bool S21SymmetricMatrix::EqMatrix(const S21SymmetricMatrix& other) const {
+  if (size_ != other.size_) return false;
+  for (std::size_t k = 0; k < values_.size(); k++) {
+    if (std::fabs(values_[k] - other.values_[k]) >= S21Matrix::kEpsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void S21SymmetricMatrix::SumMatrix(const S21SymmetricMatrix& other) {
+  if (size_ != other.size_) {
+    throw std::logic_error("Can't sum matrices with different sizes\n");
+  }
+  for (std::size_t k = 0; k < values_.size(); k++) {
+    values_[k] += other.values_[k];
+  }
+}
+
+void S21SymmetricMatrix::SubMatrix(const S21SymmetricMatrix& other) {
+  if (size_ != other.size_) {
+    throw std::logic_error("Can't subtract matrices with different sizes\n");
+  }
+  for (std::size_t k = 0; k < values_.size(); k++) {
+    values_[k] -= other.values_[k];
+  }
+}
+
+void S21SymmetricMatrix::MulNumber(const double num) {
+  for (double& value : values_) value *= num;
+}
+
+// Row i of L needs rows 0 .. i - 1 only, and every dot product runs over
+// the contiguous starts of two packed rows
+bool S21SymmetricMatrix::FactorCholesky() {
+  for (int i = 0; i < size_; i++) {
+    double* row = Row(i);
+    for (int j = 0; j <= i; j++) {
+      const double* other = Row(j);
+      double sum = row[j];
+      for (int k = 0; k < j; k++) sum -= row[k] * other[k];
+      if (j < i) {
+        row[j] = sum / other[j];
+      } else if (sum > 0) {
+        row[i] = std::sqrt(sum);
+      } else {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+double S21SymmetricMatrix::Determinant() const {
+  S21SymmetricMatrix factor(*this);
+  if (!factor.FactorCholesky()) return GeneralDense().Determinant();
+
+  // Elimination meets the pivots l(i, i)^2, which count as zero below
+  // kEpsilon as in S21Matrix::Determinant
+  double result = 1.0;
+  for (int i = 0; i < size_; i++) {
+    double pivot = factor.Row(i)[i] * factor.Row(i)[i];
+    if (pivot < S21Matrix::kEpsilon) return 0.0;
+    result *= pivot;
+  }
+  return result;
+}
+
+// A^-1 = L^-T * L^-1 with both factors kept packed: L^-1 is lower
+// triangular as well, and row i of the result's lower triangle sums
+// L^-1(k, i) * row k of L^-1 over k >= i
+S21SymmetricMatrix S21SymmetricMatrix::InverseMatrix() const {
+  S21SymmetricMatrix factor(*this);
+  if (!factor.FactorCholesky()) {
+    return S21SymmetricMatrix(GeneralDense().InverseMatrix());
+  }
+  // Singular when a pivot l(i, i)^2 or their product is below kEpsilon, the
+  // same test Determinant makes
+  double det = 1.0;
+  for (int i = 0; i < size_ && det != 0.0; i++) {
+    double pivot = factor.Row(i)[i] * factor.Row(i)[i];
+    det = pivot < S21Matrix::kEpsilon ? 0.0 : det * pivot;
+  }
+  if (det < S21Matrix::kEpsilon) {
+    throw std::logic_error("Can't count matrix with its determinant = 0\n");
+  }
+
+  int n = size_;
+  S21SymmetricMatrix l_inv(n);
+  for (int i = 0; i < n; i++) {
+    const double* l = factor.Row(i);
+    double* y = l_inv.Row(i);
+    y[i] = 1.0;
+    for (int k = 0; k < i; k++) {
+      const double* src = l_inv.Row(k);
+      for (int j = 0; j <= k; j++) y[j] -= l[k] * src[j];
+    }
+    double scale = 1.0 / l[i];
+    for (int j = 0; j <= i; j++) y[j] *= scale;
+  }
+
+  S21SymmetricMatrix result(n);
+  S21ForEachRowBand(n, n, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      double* x = result.Row(i);
+      for (int k = i; k < n; k++) {
+        const double* src = l_inv.Row(k);
+        double weight = src[i];
+        for (int j = 0; j <= i; j++) x[j] += weight * src[j];
+      }
+    }
+  });
+  return result;
+}
+
+// Row i of the product combines the rows of dense weighted by row i of the
+// matrix, whose elements right of the diagonal are read from column i of
+// the packed triangle
+S21Matrix S21SymmetricMatrix::operator*(const S21Matrix& dense) const {
+  if (dense.rows_ != size_) {
+    throw std::logic_error(
+        "Can't multiply matrices with 1st matrix's columns count not being "
+        "equal to 2nd matrix's rows count\n");
+  }
+
+  int cols = dense.cols_;
+  S21Matrix result(size_, cols);
+  S21ForEachRowBand(size_, cols, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      double* out = result.Row(i);
+      for (int j = 0; j < size_; j++) {
+        double factor = j <= i ? Row(i)[j] : Row(j)[i];
+        if (factor == 0.0) continue;
+        const double* in = dense.Row(j);
+        for (int k = 0; k < cols; k++) out[k] += factor * in[k];
+      }
+    }
+  });
+  return result;
+}
+
+bool S21SymmetricMatrix::operator==(const S21SymmetricMatrix& other) const {
+  return EqMatrix(other);
+}
+
+std::size_t S21SymmetricMatrix::Index(int row, int col) const {
+  if (row >= size_ || col >= size_ || row < 0 || col < 0) {
+    throw std::out_of_range("Incorrect input, index is out of range\n");
+  }
+  if (col > row) std::swap(row, col);
+  return static_cast<std::size_t>(row) * (row + 1) / 2 + col;
+}
+
+double& S21SymmetricMatrix::operator()(int row, int col) {
+  return values_[Index(row, col)];
+}
+
+double S21SymmetricMatrix::operator()(int row, int col) const {
+  return values_[Index(row, col)];
+}
+
+int S21SymmetricMatrix::GetSize() const { return size_; }
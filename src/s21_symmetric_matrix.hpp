@@ -0,0 +1,59 @@
+#ifndef S21_SYMMETRIC_MATRIX_HPP
+#define S21_SYMMETRIC_MATRIX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.hpp"
+
+// Symmetric matrix in packed storage: only the lower triangle is kept, row
+// after row, so element (i, j) with j <= i is values_[i * (i + 1) / 2 + j]
+// and (j, i) is the same element. It takes n * (n + 1) / 2 elements instead
+// of n * n, half the memory of a dense covariance or stiffness matrix.
+//
+// Positive definite matrices are factored by Cholesky in the packed
+// storage; other symmetric matrices fall back to the dense LU path.
+class S21SymmetricMatrix {
+ public:
+  explicit S21SymmetricMatrix(int size);
+  // Keeps the lower triangle of dense, which has to be square
+  explicit S21SymmetricMatrix(const S21Matrix& dense);
+
+  // Methods
+  // Dense copy declared kSymmetric, see S21Matrix::SetStructure
+  S21Matrix ToDense() const;
+  bool EqMatrix(const S21SymmetricMatrix& other) const;
+  void SumMatrix(const S21SymmetricMatrix& other);
+  void SubMatrix(const S21SymmetricMatrix& other);
+  void MulNumber(const double num);
+  double Determinant() const;
+  S21SymmetricMatrix InverseMatrix() const;
+
+  // Overloaded operators
+  S21Matrix operator*(const S21Matrix& dense) const;
+  bool operator==(const S21SymmetricMatrix& other) const;
+  // (row, col) and (col, row) refer to the same element
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+  // Accessors
+  int GetSize() const;
+
+ private:
+  int size_;
+  std::vector<double> values_;
+
+  double* Row(int i) {
+    return values_.data() + static_cast<std::size_t>(i) * (i + 1) / 2;
+  }
+  const double* Row(int i) const {
+    return values_.data() + static_cast<std::size_t>(i) * (i + 1) / 2;
+  }
+  std::size_t Index(int row, int col) const;
+  S21Matrix GeneralDense() const;
+  // Overwrites the elements with the packed Cholesky factor L of
+  // A = L * L^T; false when A is not positive definite
+  bool FactorCholesky();
+};
+
+#endif
@@ -0,0 +1,141 @@
+#include "s21_thread_pool.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+thread_local bool in_parallel_region = false;
+
+int DefaultThreadCount() {
+  const char* env = std::getenv("S21_NUM_THREADS");
+  if (env != nullptr) {
+    int count = std::atoi(env);
+    if (count > 0) return count;
+  }
+  int hardware = static_cast<int>(std::thread::hardware_concurrency());
+  return hardware > 0 ? hardware : 1;
+}
+
+}  // namespace
+
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool(DefaultThreadCount());
+  return pool;
+}
+
+S21ThreadPool::S21ThreadPool(int count)
+    : job_(nullptr), generation_(0), busy_(0), stop_(false) {
+  StartWorkers(count);
+}
+
+S21ThreadPool::~S21ThreadPool() { StopWorkers(); }
+
+int S21ThreadPool::GetThreadCount() const {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+void S21ThreadPool::SetThreadCount(int count) {
+  if (count < 1) {
+    throw std::invalid_argument("Number of threads should be > 0\n");
+  }
+
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  if (count == GetThreadCount()) return;
+  StopWorkers();
+  StartWorkers(count);
+}
+
+void S21ThreadPool::ParallelFor(int begin, int end, int grain,
+                                const std::function<void(int, int)>& body) {
+  if (begin >= end) return;
+  if (grain < 1) grain = 1;
+
+  std::unique_lock<std::mutex> run_lock(run_mutex_, std::try_to_lock);
+  if (!run_lock.owns_lock() || workers_.empty() || in_parallel_region ||
+      end - begin <= grain) {
+    body(begin, end);
+    return;
+  }
+
+  Job job{&body, end, grain, begin, nullptr};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    generation_++;
+  }
+  wake_.notify_all();
+
+  RunChunks(job);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  job_ = nullptr;
+  done_.wait(lock, [this] { return busy_ == 0; });
+  if (job.error) std::rethrow_exception(job.error);
+}
+
+void S21ThreadPool::StartWorkers(int count) {
+  stop_ = false;
+  for (int i = 1; i < count; i++) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+  }
+}
+
+void S21ThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+  workers_.clear();
+}
+
+void S21ThreadPool::WorkerLoop() {
+  in_parallel_region = true;
+  unsigned long seen = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+    if (stop_) return;
+    seen = generation_;
+    Job* job = job_;
+    if (job == nullptr) continue;
+
+    busy_++;
+    lock.unlock();
+    RunChunks(*job);
+    lock.lock();
+    if (--busy_ == 0) done_.notify_all();
+  }
+}
+
+// Chunks are claimed under mutex_; the work inside a chunk is large enough
+// that the lock is never the bottleneck.
+void S21ThreadPool::RunChunks(Job& job) {
+  bool saved = in_parallel_region;
+  in_parallel_region = true;
+  while (true) {
+    int first, last;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (job.next >= job.end || job.error) break;
+      first = job.next;
+      last = job.end - first > job.grain ? first + job.grain : job.end;
+      job.next = last;
+    }
+    try {
+      (*job.body)(first, last);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!job.error) job.error = std::current_exception();
+    }
+  }
+  in_parallel_region = saved;
+}
+
+void S21SetNumThreads(int count) {
+  S21ThreadPool::Instance().SetThreadCount(count);
+}
+
+int S21GetNumThreads() { return S21ThreadPool::Instance().GetThreadCount(); }
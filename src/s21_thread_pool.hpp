@@ -0,0 +1,78 @@
+#ifndef S21_THREAD_POOL_HPP
+#define S21_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Library-wide pool of worker threads. The initial size comes from the
+// S21_NUM_THREADS environment variable when it is set, otherwise from
+// std::thread::hardware_concurrency(). The size counts the calling thread,
+// so a pool of size 1 has no workers and runs everything inline.
+class S21ThreadPool {
+ public:
+  static S21ThreadPool& Instance();
+
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  int GetThreadCount() const;
+  void SetThreadCount(int count);
+
+  // Calls body(first, last) on disjoint chunks of at most grain indices that
+  // together cover [begin, end), and returns once all of them are done. The
+  // caller works on chunks too. Nested calls, calls made while another
+  // thread owns the pool and ranges of a single chunk run inline.
+  void ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int)>& body);
+
+ private:
+  struct Job {
+    const std::function<void(int, int)>* body;
+    int end, grain;
+    int next;
+    std::exception_ptr error;
+  };
+
+  explicit S21ThreadPool(int count);
+  void StartWorkers(int count);
+  void StopWorkers();
+  void WorkerLoop();
+  void RunChunks(Job& job);
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  Job* job_;
+  unsigned long generation_;
+  int busy_;
+  bool stop_;
+};
+
+void S21SetNumThreads(int count);
+int S21GetNumThreads();
+
+// Element-wise passes over fewer elements than this stay on the calling
+// thread; the pool only pays off once a pass leaves L2.
+constexpr long kS21ParallelElements = 1L << 16;
+
+// Calls body(first, last) over row ranges covering [0, rows) of a
+// rows x cols matrix. Small matrices are handled in a single direct call,
+// without building a std::function; larger ones are split across the pool.
+template <typename Body>
+void S21ForEachRowBand(int rows, int cols, const Body& body) {
+  if (static_cast<long>(rows) * cols < kS21ParallelElements) {
+    body(0, rows);
+  } else {
+    int grain = static_cast<int>(kS21ParallelElements / 4 / cols) + 1;
+    S21ThreadPool::Instance().ParallelFor(0, rows, grain, body);
+  }
+}
+
+#endif
@@ -1,5 +1,32 @@
 #include "tests.hpp"
 
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <utility>
+
+static void FillPattern(S21Matrix& matrix, int seed) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      matrix(i, j) = ((i * 31 + j * 17 + seed) % 23) / 7.0 - 1.5;
+    }
+  }
+}
+
+static S21Matrix NaiveProduct(S21Matrix& a, S21Matrix& b) {
+  S21Matrix result(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      double sum = 0.0;
+      for (int k = 0; k < a.GetCols(); k++) sum += a(i, k) * b(k, j);
+      result(i, j) = sum;
+    }
+  }
+  return result;
+}
+
 TEST(Constructors, BasicConstructor) {
   S21Matrix matrix;
   EXPECT_EQ(3, matrix.GetRows());
@@ -39,6 +66,31 @@ TEST(Constructors, MoveConstructor) {
   EXPECT_EQ(1, matrix == matrix_copy);
 }
 
+TEST(Constructors, MoveAssignment) {
+  S21Matrix matrix(4, 5);
+  matrix(3, 4) = 7;
+  S21Matrix target(2, 2);
+  target = std::move(matrix);
+  EXPECT_EQ(0, matrix.GetRows());
+  EXPECT_EQ(0, matrix.GetCols());
+  EXPECT_EQ(4, target.GetRows());
+  EXPECT_EQ(5, target.GetCols());
+  EXPECT_DOUBLE_EQ(7, target(3, 4));
+}
+
+TEST(Constructors, CopyAssignmentSameShape) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 1) = 3;
+  S21Matrix target(2, 2);
+  target(1, 1) = 5;
+  target = matrix;
+  EXPECT_EQ(1, target == matrix);
+  S21Matrix& alias = target;
+  target = alias;
+  EXPECT_DOUBLE_EQ(3, target(0, 1));
+  EXPECT_DOUBLE_EQ(0, target(1, 1));
+}
+
 TEST(Operators, EqOperator) {
   S21Matrix matrix_3x3(3, 3);
   S21Matrix matrix2_3x3(3, 3);
@@ -208,6 +260,87 @@ TEST(Operators, MultNumberOperator) {
   EXPECT_DOUBLE_EQ(10.24, matrix(1, 1));
 }
 
+TEST(Operators, FusedExpression) {
+  S21Matrix a(2, 2), b(2, 2), c(2, 2);
+  a(0, 0) = 1, a(0, 1) = 2, a(1, 0) = 3, a(1, 1) = 4;
+  b(0, 0) = 5, b(0, 1) = 6, b(1, 0) = 7, b(1, 1) = 8;
+  c(0, 0) = 1, c(0, 1) = 1, c(1, 0) = 1, c(1, 1) = 1;
+  S21Matrix result = a + b * 2.0 - c;
+  EXPECT_DOUBLE_EQ(10, result(0, 0));
+  EXPECT_DOUBLE_EQ(13, result(0, 1));
+  EXPECT_DOUBLE_EQ(16, result(1, 0));
+  EXPECT_DOUBLE_EQ(19, result(1, 1));
+
+  result = 0.5 * (a - c) + c;
+  EXPECT_DOUBLE_EQ(1, result(0, 0));
+  EXPECT_DOUBLE_EQ(2.5, result(1, 1));
+
+  result += a + a;
+  EXPECT_DOUBLE_EQ(3, result(0, 0));
+  result -= b - a;
+  EXPECT_DOUBLE_EQ(-1, result(0, 0));
+  EXPECT_EQ(1, a + b == b + a);
+}
+
+TEST(Operators, FusedExpressionProduct) {
+  S21Matrix a(2, 3), b(3, 2);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  S21Matrix ref = NaiveProduct(a, b);
+  S21Matrix result = (a + a) * b * 0.5;
+  EXPECT_EQ(1, result == ref);
+  result = a * (b + b) * 0.5;
+  EXPECT_EQ(1, result == ref);
+}
+
+TEST(Operators, MethodsOnExpressions) {
+  S21Matrix a(2, 2), b(2, 2);
+  a(0, 0) = 1, a(0, 1) = 2, a(1, 0) = 3, a(1, 1) = 4;
+  b(0, 0) = 1, b(0, 1) = 0, b(1, 0) = 0, b(1, 1) = 1;
+  EXPECT_DOUBLE_EQ(4, (a + b).Determinant());
+  EXPECT_DOUBLE_EQ(6, (a * 2.0).Transpose()(0, 1));
+  S21Matrix inverse = (a - b).InverseMatrix();
+  EXPECT_DOUBLE_EQ(-0.5, inverse(0, 0));
+  EXPECT_DOUBLE_EQ(0.5, inverse(1, 0));
+  EXPECT_DOUBLE_EQ(2, (a + b).CalcComplements()(1, 1));
+  EXPECT_DOUBLE_EQ(5, (a + b)(1, 1));
+  EXPECT_THROW((a + b)(2, 0), std::out_of_range);
+  EXPECT_TRUE((a * 2.0).EqMatrix(a + a));
+
+  int sign = 0;
+  EXPECT_NEAR(std::log(4.0), (a + b).LogDeterminant(sign), 1e-12);
+  EXPECT_EQ(1, sign);
+
+  // Eval takes a snapshot that later writes to the operands don't change
+  S21Matrix sum = (a + b).Eval();
+  a(0, 0) = 10;
+  EXPECT_DOUBLE_EQ(2, sum(0, 0));
+}
+
+TEST(Operators, FusedExpressionInvalid) {
+  S21Matrix a(2, 2), b(2, 3), c(2, 2);
+  EXPECT_THROW(S21Matrix result = a + c - b, std::logic_error);
+  EXPECT_THROW(S21Matrix result = a * 2.0 + b, std::logic_error);
+  EXPECT_THROW(c += a - b, std::logic_error);
+}
+
+TEST(Operators, ExpiringOperands) {
+  S21Matrix a(2, 3), b(3, 2), c(2, 2);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  FillPattern(c, 3);
+  S21Matrix ref = NaiveProduct(a, b);
+  S21Matrix result = a * b + c;
+  EXPECT_EQ(1, result - c == ref);
+  result = c - a * b;
+  EXPECT_EQ(1, c - result == ref);
+  result = a * b * 2.0 - a * b;
+  EXPECT_EQ(1, result == ref);
+  result = 3.0 * (a * b) + (a * b) * -2.0;
+  EXPECT_EQ(1, result == ref);
+  EXPECT_THROW(S21Matrix bad = a * b + a, std::logic_error);
+}
+
 TEST(Operators, OperatorParentheses) {
   S21Matrix matrix;
   matrix(1, 2) = 3;
@@ -220,6 +353,47 @@ TEST(Operators, OperatorParenthesesInvalid) {
   EXPECT_THROW(matrix(3, 0), std::out_of_range);
 }
 
+static bool IsTransposeOf(const S21Matrix& result, const S21Matrix& matrix) {
+  bool equal = result.GetRows() == matrix.GetCols() &&
+               result.GetCols() == matrix.GetRows();
+  for (int i = 0; equal && i < matrix.GetRows(); i++) {
+    for (int j = 0; equal && j < matrix.GetCols(); j++) {
+      equal = result(j, i) == matrix(i, j);
+    }
+  }
+  return equal;
+}
+
+TEST(Methods, TransposeTiled) {
+  S21Matrix tall(301, 77), wide(3, 150);
+  FillPattern(tall, 1);
+  FillPattern(wide, 2);
+  EXPECT_TRUE(IsTransposeOf(tall.Transpose(), tall));
+  EXPECT_TRUE(IsTransposeOf(wide.Transpose(), wide));
+  EXPECT_TRUE(IsTransposeOf(tall.Block(5, 9, 200, 40).Transpose(),
+                            S21Matrix(tall.Block(5, 9, 200, 40))));
+}
+
+TEST(Methods, TransposeInPlace) {
+  S21Matrix square(70, 70);
+  FillPattern(square, 3);
+  S21Matrix copy(square);
+  square.TransposeInPlace();
+  EXPECT_TRUE(IsTransposeOf(square, copy));
+
+  // Padded rows, packed rows and a shape that no longer fits the buffer
+  int shapes[][2] = {{37, 53}, {53, 37}, {4, 7}, {1, 9}, {9, 2}};
+  for (auto& shape : shapes) {
+    S21Matrix matrix(shape[0], shape[1]);
+    FillPattern(matrix, shape[1]);
+    copy = matrix;
+    matrix.TransposeInPlace();
+    EXPECT_TRUE(IsTransposeOf(matrix, copy));
+    matrix.SetRows(matrix.GetRows() + 1);
+    EXPECT_DOUBLE_EQ(0, matrix(matrix.GetRows() - 1, 0));
+  }
+}
+
 TEST(Methods, Determinant1x1) {
   S21Matrix matrix(1, 1);
   matrix(0, 0) = 21;
@@ -269,6 +443,64 @@ TEST(Methods, CalcCompl1x1) {
   EXPECT_EQ(1, matrix.CalcComplements() == ref);
 }
 
+static S21Matrix MinorCofactors(const S21Matrix& matrix) {
+  int n = matrix.GetRows();
+  S21Matrix result(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      double minor = matrix.Minor(i, j).Determinant();
+      result(i, j) = (i + j) % 2 ? -minor : minor;
+    }
+  }
+  return result;
+}
+
+TEST(Methods, CalcComplMatchesMinors) {
+  S21Matrix matrix(9, 9);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) matrix(i, j) = ((i * 7 + j * j * 3) % 11) - 5;
+  }
+  EXPECT_EQ(1, matrix.CalcComplements() == MinorCofactors(matrix));
+}
+
+TEST(Methods, CalcComplSingular) {
+  // Rank 2: the cofactors come from the rank-one adjugate
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 1, matrix(0, 1) = 2, matrix(0, 2) = 3;
+  matrix(1, 0) = 4, matrix(1, 1) = 5, matrix(1, 2) = 6;
+  matrix(2, 0) = 7, matrix(2, 1) = 8, matrix(2, 2) = 9;
+  S21Matrix ref(3, 3);
+  ref(0, 0) = -3, ref(0, 1) = 6, ref(0, 2) = -3;
+  ref(1, 0) = 6, ref(1, 1) = -12, ref(1, 2) = 6;
+  ref(2, 0) = -3, ref(2, 1) = 6, ref(2, 2) = -3;
+  EXPECT_EQ(1, matrix.CalcComplements() == ref);
+
+  S21Matrix wide(6, 6);
+  FillPattern(wide, 3);
+  wide.SetCols(5);
+  wide.SetCols(6);
+  EXPECT_EQ(1, wide.CalcComplements() == MinorCofactors(wide));
+
+  // Rank 1: every minor of order 2 vanishes
+  S21Matrix outer(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) outer(i, j) = (i + 1) * (j - 2);
+  }
+  EXPECT_EQ(1, outer.CalcComplements() == S21Matrix(4, 4));
+}
+
+TEST(Methods, CalcComplLarge) {
+  S21Matrix matrix(200, 200);
+  FillPattern(matrix, 1);
+  for (int i = 0; i < 200; i++) matrix(i, i) += 4.0;
+  // adj(A) * A = det(A) * I; scaling by 1 / det keeps the check readable
+  S21Matrix complements = matrix.CalcComplements();
+  double det = S21LU(matrix).Determinant();
+  S21Matrix identity(200, 200);
+  for (int i = 0; i < 200; i++) identity(i, i) = 1.0;
+  EXPECT_EQ(1, complements.Transposed() * matrix * (1.0 / det) == identity);
+}
+
 TEST(Methods, CalcComplInvalid) {
   S21Matrix matrix(3, 2);
   EXPECT_THROW(matrix.CalcComplements(), std::logic_error);
@@ -301,6 +533,620 @@ TEST(Methods, InverseInvalid) {
   EXPECT_THROW(matrix.InverseMatrix(), std::logic_error);
 }
 
+TEST(Methods, InverseLarge) {
+  int n = 120;
+  S21Matrix matrix(n, n);
+  FillPattern(matrix, 11);
+  for (int i = 0; i < n; i++) matrix(i, i) += n;
+  S21Matrix product = matrix * matrix.InverseMatrix();
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) identity(i, i) = 1.0;
+  EXPECT_EQ(1, product == identity);
+}
+
+TEST(Methods, InverseNeedsPivoting) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 0, matrix(0, 1) = 1, matrix(0, 2) = 0;
+  matrix(1, 0) = 0, matrix(1, 1) = 0, matrix(1, 2) = 2;
+  matrix(2, 0) = 4, matrix(2, 1) = 0, matrix(2, 2) = 0;
+  S21Matrix ref(3, 3);
+  ref(0, 2) = 0.25, ref(1, 0) = 1, ref(2, 1) = 0.5;
+  EXPECT_EQ(1, matrix.InverseMatrix() == ref);
+}
+
+TEST(Methods, InverseNonSquareInvalid) {
+  S21Matrix matrix(2, 3);
+  EXPECT_THROW(matrix.InverseMatrix(), std::logic_error);
+}
+
+TEST(LU, DeterminantMatchesGauss) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 0, matrix(0, 1) = 12, matrix(0, 2) = 22;
+  matrix(1, 0) = 1, matrix(1, 1) = 2, matrix(1, 2) = 22;
+  matrix(2, 0) = 1, matrix(2, 1) = 12, matrix(2, 2) = 1;
+  S21LU lu(matrix);
+  EXPECT_EQ(3, lu.GetSize());
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(472, lu.Determinant(), 1e-9);
+}
+
+TEST(LU, SolveManyRightHandSides) {
+  int n = 60, rhs = 300;
+  S21Matrix matrix(n, n);
+  FillPattern(matrix, 7);
+  for (int i = 0; i < n; i++) matrix(i, i) += 10;
+  S21Matrix x(n, rhs);
+  FillPattern(x, 3);
+  S21Matrix b = matrix * x;
+  S21LU lu(matrix);
+  EXPECT_EQ(1, lu.Solve(b) == x);
+  EXPECT_EQ(1, lu.Inverse() == matrix.InverseMatrix());
+}
+
+TEST(LU, Singular) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 1, matrix(0, 1) = 2;
+  matrix(1, 0) = 2, matrix(1, 1) = 4;
+  S21LU lu(matrix);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_DOUBLE_EQ(0, lu.Determinant());
+  EXPECT_THROW(lu.Inverse(), std::logic_error);
+  EXPECT_THROW(lu.Solve(matrix), std::logic_error);
+}
+
+// Pseudo-random elements in [-1, 1); unlike FillPattern the matrix has full
+// rank at any size, and its pivots come from all over each column
+static void FillHashed(S21Matrix& matrix, unsigned seed) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      unsigned hash = (i * 2654435761u) ^ (j * 40503u + seed);
+      hash = (hash ^ (hash >> 15)) * 2246822519u;
+      matrix(i, j) = (hash >> 8) % 2000 / 1000.0 - 1;
+    }
+  }
+}
+
+TEST(LU, Blocked) {
+  int n = 200;
+  S21Matrix a(n, n), b(n, n), x(n, 3);
+  FillHashed(a, 1);
+  FillHashed(b, 2);
+  FillHashed(x, 3);
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; i++) identity(i, i) = 1;
+  S21LU lu(a);
+  EXPECT_EQ(1, lu.Solve(a * x) == x);
+  EXPECT_EQ(1, lu.Inverse() * a == identity);
+
+  int sign_a = 0, sign_b = 0, sign_ab = 0, sign_t = 0;
+  double log_a = a.LogDeterminant(sign_a);
+  double log_b = b.LogDeterminant(sign_b);
+  S21Matrix ab = a * b;
+  EXPECT_NEAR(log_a + log_b, ab.LogDeterminant(sign_ab), 1e-8);
+  EXPECT_EQ(sign_a * sign_b, sign_ab);
+  EXPECT_NEAR(log_a, a.Transpose().LogDeterminant(sign_t), 1e-8);
+  EXPECT_EQ(sign_a, sign_t);
+  EXPECT_NEAR(1, a.Determinant() / (sign_a * std::exp(log_a)), 1e-9);
+}
+
+TEST(LU, LogDeterminant) {
+  // Upper triangular but undeclared, with its first two rows swapped:
+  // det = -(100^150 * (-100)^150), far beyond double
+  int n = 300;
+  S21Matrix matrix(n, n);
+  FillHashed(matrix, 4);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < i; j++) matrix(i, j) = 0;
+    matrix(i, i) = i % 2 ? -100 : 100;
+  }
+  S21Matrix swapped(matrix);
+  for (int j = 0; j < n; j++) std::swap(swapped(0, j), swapped(1, j));
+
+  int sign = 0;
+  EXPECT_NEAR(n * std::log(100.0), swapped.LogDeterminant(sign), 1e-9);
+  EXPECT_EQ(-1, sign);
+  EXPECT_TRUE(std::isinf(swapped.Determinant()));
+  matrix.SetStructure(S21Structure::kUpperTriangular);
+  EXPECT_NEAR(n * std::log(100.0), matrix.LogDeterminant(sign), 1e-9);
+  EXPECT_EQ(1, sign);
+
+  S21Matrix spd(n, n);
+  for (int i = 0; i < n; i++) spd(i, i) = 1e-3;
+  spd.SetStructure(S21Structure::kPositiveDefinite);
+  EXPECT_NEAR(n * std::log(1e-3), spd.LogDeterminant(sign), 1e-9);
+  EXPECT_EQ(1, sign);
+  EXPECT_EQ(0, spd.Determinant());
+
+  for (int j = 0; j < n; j++) swapped(5, j) = 0;
+  EXPECT_TRUE(std::isinf(swapped.LogDeterminant(sign)));
+  EXPECT_EQ(0, sign);
+  EXPECT_EQ(0, swapped.Determinant());
+  S21Matrix rect(2, 3);
+  EXPECT_THROW(rect.LogDeterminant(sign), std::logic_error);
+
+  // Numerically singular: the last row repeats the first up to 1e-9, so
+  // the last pivot is far below kEpsilon, below kBlockedSize and above it
+  for (int size : {40, 100}) {
+    S21Matrix near(size, size);
+    FillHashed(near, 6);
+    for (int j = 0; j < size; j++) {
+      near(size - 1, j) = near(0, j) + 1e-9 * (j % 3);
+    }
+    EXPECT_EQ(0, near.Determinant());
+    EXPECT_TRUE(std::isinf(near.LogDeterminant(sign)));
+    EXPECT_EQ(0, sign);
+    EXPECT_THROW(near.InverseMatrix(), std::logic_error);
+    S21LU lu(near);
+    EXPECT_FALSE(lu.IsSingular());
+    EXPECT_EQ(0, lu.Determinant());
+  }
+}
+
+TEST(LU, Invalid) {
+  S21Matrix matrix(2, 3);
+  EXPECT_THROW(S21LU lu(matrix), std::logic_error);
+  S21Matrix square(3, 3);
+  square(0, 0) = square(1, 1) = square(2, 2) = 1;
+  S21LU lu(square);
+  EXPECT_THROW(lu.Solve(matrix), std::logic_error);
+}
+
+TEST(Fixed, Determinants) {
+  S21FixedMatrix<2, 2> m2;
+  m2(0, 0) = 14, m2(0, 1) = 22, m2(1, 0) = 31, m2(1, 1) = 12;
+  EXPECT_DOUBLE_EQ(-514, m2.Determinant());
+
+  S21FixedMatrix<3, 3> m3;
+  m3(0, 0) = 0, m3(0, 1) = 12, m3(0, 2) = 22;
+  m3(1, 0) = 1, m3(1, 1) = 2, m3(1, 2) = 22;
+  m3(2, 0) = 1, m3(2, 1) = 12, m3(2, 2) = 1;
+  EXPECT_DOUBLE_EQ(472, m3.Determinant());
+
+  S21Matrix dynamic(6, 6);
+  FillPattern(dynamic, 4);
+  S21FixedMatrix<6, 6> m6(dynamic);
+  EXPECT_NEAR(dynamic.Determinant(), m6.Determinant(), 1e-9);
+  EXPECT_EQ(6, m6.GetRows());
+  static_assert(S21FixedMatrix<2, 5>::GetCols() == 5);
+}
+
+TEST(Fixed, ComplementsAndInverse4x4) {
+  S21Matrix dynamic(4, 4);
+  dynamic(0, 0) = 1, dynamic(0, 1) = 20, dynamic(0, 2) = 4, dynamic(0, 3) = 3;
+  dynamic(1, 0) = 14, dynamic(1, 1) = 4, dynamic(1, 2) = 21, dynamic(1, 3) = 3;
+  dynamic(2, 0) = 22, dynamic(2, 1) = 12, dynamic(2, 2) = 15, dynamic(2, 3) = 5;
+  dynamic(3, 0) = 12, dynamic(3, 1) = 5, dynamic(3, 2) = 12, dynamic(3, 3) = 2;
+  S21FixedMatrix<4, 4> fixed(dynamic);
+  EXPECT_NEAR(dynamic.Determinant(), fixed.Determinant(), 1e-6);
+  S21Matrix complements(fixed.CalcComplements());
+  EXPECT_EQ(1, complements == dynamic.CalcComplements());
+  S21Matrix inverse(fixed.InverseMatrix());
+  EXPECT_EQ(1, inverse == dynamic.InverseMatrix());
+  S21FixedMatrix<4, 4> identity;
+  for (int i = 0; i < 4; i++) identity(i, i) = 1;
+  EXPECT_EQ(1, fixed * fixed.InverseMatrix() == identity);
+}
+
+TEST(Fixed, InverseSmallAndLarge) {
+  S21FixedMatrix<3, 3> m3;
+  m3(0, 0) = 2, m3(0, 1) = 5, m3(0, 2) = 7;
+  m3(1, 0) = 8, m3(1, 1) = 3, m3(1, 2) = 4;
+  m3(2, 0) = 5, m3(2, 1) = -2, m3(2, 2) = -3;
+  S21FixedMatrix<3, 3> ref;
+  ref(0, 0) = -1, ref(0, 1) = 1, ref(0, 2) = -1;
+  ref(1, 0) = 44, ref(1, 1) = -41, ref(1, 2) = 48;
+  ref(2, 0) = -31, ref(2, 1) = 29, ref(2, 2) = -34;
+  EXPECT_EQ(1, m3.InverseMatrix() == ref);
+
+  S21Matrix dynamic(5, 5);
+  FillPattern(dynamic, 2);
+  for (int i = 0; i < 5; i++) dynamic(i, i) += 5;
+  S21FixedMatrix<5, 5> m5(dynamic);
+  EXPECT_EQ(1, S21Matrix(m5.InverseMatrix()) == dynamic.InverseMatrix());
+  EXPECT_EQ(1, S21Matrix(m5.CalcComplements()) == dynamic.CalcComplements());
+
+  S21FixedMatrix<2, 2> singular;
+  singular(0, 0) = singular(0, 1) = singular(1, 0) = singular(1, 1) = 1;
+  EXPECT_THROW(singular.InverseMatrix(), std::logic_error);
+
+  // A pivot below kEpsilon is singular here too, even though the product of
+  // the pivots is 1, the same verdict S21Matrix reaches
+  S21FixedMatrix<2, 2> small_pivot;
+  small_pivot(0, 0) = 1e-7, small_pivot(1, 1) = 1e7;
+  S21Matrix dynamic_small(small_pivot);
+  EXPECT_EQ(dynamic_small.Determinant(), small_pivot.Determinant());
+  EXPECT_EQ(0, small_pivot.Determinant());
+  EXPECT_THROW(small_pivot.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(dynamic_small.InverseMatrix(), std::logic_error);
+}
+
+TEST(Fixed, Arithmetic) {
+  S21FixedMatrix<3, 2> a;
+  a(0, 0) = 2, a(0, 1) = 4, a(1, 0) = 5, a(1, 1) = 2, a(2, 0) = 8, a(2, 1) = 3;
+  S21FixedMatrix<2, 3> b;
+  b(0, 0) = 3, b(0, 1) = 2, b(0, 2) = 0, b(1, 0) = 4, b(1, 1) = 5, b(1, 2) = 6;
+  S21FixedMatrix<3, 3> product = a * b;
+  EXPECT_DOUBLE_EQ(22, product(0, 0));
+  EXPECT_DOUBLE_EQ(18, product(2, 2));
+  EXPECT_EQ(1, b + b == b * 2.0);
+  EXPECT_DOUBLE_EQ(8, a.Transpose()(0, 2));
+  a -= a;
+  a += b.Transpose() * 0.5;
+  EXPECT_DOUBLE_EQ(1.5, a(0, 0));
+  EXPECT_THROW(a(3, 0), std::out_of_range);
+}
+
+TEST(Fixed, Conversions) {
+  S21Matrix dynamic(2, 3);
+  FillPattern(dynamic, 1);
+  S21FixedMatrix<2, 3> fixed(dynamic);
+  EXPECT_EQ(1, static_cast<S21Matrix>(fixed) == dynamic);
+  EXPECT_THROW((S21FixedMatrix<3, 2>(dynamic)), std::logic_error);
+}
+
+TEST(View, BlockArithmetic) {
+  S21Matrix matrix(5, 6);
+  FillPattern(matrix, 3);
+  S21MatrixView block = matrix.Block(1, 2, 3, 4);
+  EXPECT_EQ(3, block.GetRows());
+  EXPECT_EQ(4, block.GetCols());
+  EXPECT_DOUBLE_EQ(matrix(2, 4), block(1, 2));
+
+  S21Matrix copy(block);
+  S21Matrix sum = copy + block;
+  EXPECT_EQ(1, sum == copy * 2.0);
+  sum -= block;
+  EXPECT_EQ(1, sum == copy);
+  EXPECT_EQ(1, block.Transpose() == copy.Transpose());
+  EXPECT_THROW(matrix.Block(3, 0, 3, 1), std::out_of_range);
+  EXPECT_THROW(matrix.Block(0, 0, 0, 1), std::out_of_range);
+}
+
+TEST(View, BlockProduct) {
+  S21Matrix a(40, 50), b(60, 30);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  S21Matrix left(a.Block(5, 10, 30, 20));
+  S21Matrix right(b.Block(7, 3, 20, 25));
+  S21Matrix ref = NaiveProduct(left, right);
+  EXPECT_EQ(1, a.Block(5, 10, 30, 20) * b.Block(7, 3, 20, 25) == ref);
+  EXPECT_EQ(1, left * b.Block(7, 3, 20, 25) == ref);
+  left.MulMatrix(b.Block(7, 3, 20, 25));
+  EXPECT_EQ(1, left == ref);
+  EXPECT_THROW(a.Block(0, 0, 2, 3) * b.Block(0, 0, 2, 3), std::logic_error);
+}
+
+TEST(View, Minor) {
+  S21Matrix matrix(4, 4);
+  matrix(0, 0) = 1, matrix(0, 1) = 20, matrix(0, 2) = 4, matrix(0, 3) = 3;
+  matrix(1, 0) = 14, matrix(1, 1) = 4, matrix(1, 2) = 21, matrix(1, 3) = 3;
+  matrix(2, 0) = 22, matrix(2, 1) = 12, matrix(2, 2) = 15, matrix(2, 3) = 5;
+  matrix(3, 0) = 12, matrix(3, 1) = 5, matrix(3, 2) = 12, matrix(3, 3) = 2;
+  S21MatrixView minor = matrix.Minor(1, 2);
+  EXPECT_EQ(3, minor.GetRows());
+  EXPECT_DOUBLE_EQ(3, minor(0, 2));
+  EXPECT_DOUBLE_EQ(22, minor(1, 0));
+  EXPECT_NEAR(217, minor.Determinant(), 1e-9);
+  S21Matrix dense(minor);
+  EXPECT_NEAR(dense.Determinant(), minor.Determinant(), 1e-9);
+  EXPECT_EQ(1, minor * matrix.Block(0, 0, 3, 3) ==
+                   dense * S21Matrix(matrix.Block(0, 0, 3, 3)));
+  EXPECT_THROW(minor.Minor(0, 0), std::logic_error);
+  EXPECT_THROW(matrix.Block(0, 0, 2, 3).Determinant(), std::logic_error);
+
+  // Views large enough for the blocked LU take it as matrices do
+  S21Matrix large(S21LU::kBlockedSize + 11, S21LU::kBlockedSize + 11);
+  FillHashed(large, 5);
+  S21MatrixView block = large.Block(3, 5, S21LU::kBlockedSize + 5,
+                                    S21LU::kBlockedSize + 5);
+  EXPECT_EQ(S21Matrix(block).Determinant(), block.Determinant());
+}
+
+TEST(View, TransposedProducts) {
+  S21Matrix a(67, 41), b(53, 41);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  S21Matrix at = a.Transpose(), bt = b.Transpose();
+
+  S21Matrix gram = a.Transposed() * a;
+  EXPECT_EQ(1, gram == NaiveProduct(at, a));
+  S21Matrix nt = a * b.Transposed();
+  EXPECT_EQ(1, nt == NaiveProduct(a, bt));
+  S21Matrix c(29, 67);
+  FillPattern(c, 3);
+  S21Matrix ct = c.Transpose();
+  S21Matrix tt = a.Transposed() * c.Transposed().Transposed().Transposed();
+  EXPECT_EQ(1, tt == NaiveProduct(at, ct));
+  EXPECT_THROW(a * b.Transposed().Transposed(), std::logic_error);
+}
+
+TEST(View, TransposedElementwise) {
+  S21Matrix a(5, 3);
+  FillPattern(a, 4);
+  S21Matrix at = a.Transpose();
+  EXPECT_EQ(1, at == a.Transposed());
+  EXPECT_EQ(1, at.EqMatrix(a.Transposed()));
+  EXPECT_FALSE(a.EqMatrix(a.Transposed()));
+  EXPECT_EQ(at(2, 4), a.Transposed()(2, 4));
+  EXPECT_EQ(a(4, 1), a.Transposed().Minor(0, 0)(0, 3));
+
+  // Reading *this out of place goes through a temporary
+  S21Matrix square(40, 40);
+  FillPattern(square, 5);
+  S21Matrix expected = square + square.Transpose();
+  square += square.Transposed();
+  EXPECT_EQ(1, square == expected);
+  EXPECT_EQ(1, square == square.Transposed());
+  square = square.Transposed() * 0.5 - square;
+  EXPECT_EQ(1, square == expected * -0.5);
+}
+
+TEST(Batch, DeterminantMatchesScalar) {
+  S21MatrixBatch batch(19, 5, 5);
+  std::vector<S21Matrix> matrices;
+  for (int m = 0; m < batch.GetCount(); m++) {
+    S21Matrix matrix(5, 5);
+    FillPattern(matrix, m * 3);
+    matrices.push_back(matrix);
+  }
+  // Zero leading pivot forces a row swap, a repeated row makes it singular
+  matrices[4](0, 0) = 0.0;
+  for (int j = 0; j < 5; j++) matrices[7](3, j) = matrices[7](1, j);
+  for (int m = 0; m < batch.GetCount(); m++) batch.SetMatrix(m, matrices[m]);
+
+  std::vector<double> det = batch.Determinant();
+  ASSERT_EQ(19u, det.size());
+  for (int m = 0; m < batch.GetCount(); m++) {
+    EXPECT_EQ(matrices[m].Determinant(), det[m]);
+  }
+  EXPECT_EQ(0.0, det[7]);
+}
+
+TEST(Batch, Inverse) {
+  S21MatrixBatch batch(10, 4, 4);
+  for (int m = 0; m < batch.GetCount(); m++) {
+    S21Matrix matrix(4, 4);
+    FillPattern(matrix, m);
+    for (int i = 0; i < 4; i++) matrix(i, i) += 4.0;
+    batch.SetMatrix(m, matrix);
+  }
+  batch(2, 0, 0) = 0.0;
+
+  S21MatrixBatch inverse = batch.InverseMatrix();
+  for (int m = 0; m < batch.GetCount(); m++) {
+    S21Matrix expected = batch.GetMatrix(m).InverseMatrix();
+    EXPECT_EQ(1, inverse.GetMatrix(m) == expected);
+  }
+
+  for (int j = 0; j < 4; j++) batch(5, 2, j) = 0.0;
+  EXPECT_THROW(batch.InverseMatrix(), std::logic_error);
+  std::vector<bool> singular;
+  inverse = batch.InverseMatrix(singular);
+  EXPECT_TRUE(singular[5]);
+  EXPECT_FALSE(singular[4]);
+  EXPECT_EQ(0.0, inverse(5, 1, 1));
+
+  // diag(1e-7, 1e7) has determinant 1 but a pivot below kEpsilon, which
+  // S21Matrix::InverseMatrix rejects as well
+  S21MatrixBatch small_pivot(3, 2, 2);
+  for (int m = 0; m < 3; m++) {
+    small_pivot(m, 0, 0) = m == 1 ? 1e-7 : 2.0;
+    small_pivot(m, 1, 1) = m == 1 ? 1e7 : 2.0;
+  }
+  EXPECT_THROW(small_pivot.GetMatrix(1).InverseMatrix(), std::logic_error);
+  small_pivot.InverseMatrix(singular);
+  EXPECT_FALSE(singular[0]);
+  EXPECT_TRUE(singular[1]);
+  EXPECT_FALSE(singular[2]);
+}
+
+TEST(Batch, MulAndTranspose) {
+  S21MatrixBatch a(9, 3, 4), b(9, 4, 2);
+  for (int m = 0; m < a.GetCount(); m++) {
+    S21Matrix left(3, 4), right(4, 2);
+    FillPattern(left, m);
+    FillPattern(right, m + 5);
+    a.SetMatrix(m, left);
+    b.SetMatrix(m, right);
+  }
+
+  S21MatrixBatch product(a);
+  product.MulMatrix(b);
+  S21MatrixBatch transposed = a.Transpose();
+  for (int m = 0; m < a.GetCount(); m++) {
+    S21Matrix left = a.GetMatrix(m), right = b.GetMatrix(m);
+    EXPECT_EQ(1, product.GetMatrix(m) == NaiveProduct(left, right));
+    EXPECT_EQ(1, transposed.GetMatrix(m) == left.Transpose());
+  }
+
+  EXPECT_THROW(a.MulMatrix(a), std::logic_error);
+  EXPECT_THROW(a.Determinant(), std::logic_error);
+  EXPECT_THROW(a.SetMatrix(9, S21Matrix(3, 4)), std::out_of_range);
+  EXPECT_THROW(a.SetMatrix(0, S21Matrix(4, 3)), std::logic_error);
+  EXPECT_THROW(S21MatrixBatch(0, 2, 2), std::invalid_argument);
+}
+
+TEST(IO, SaveAndLoad) {
+  const char* path = "s21_test_matrix.bin";
+  S21Matrix matrix(13, 21);
+  FillPattern(matrix, 4);
+  S21MatrixIO::Save(matrix, path);
+
+  S21Matrix loaded = S21MatrixIO::Load(path);
+  EXPECT_EQ(13, loaded.GetRows());
+  EXPECT_EQ(21, loaded.GetCols());
+  EXPECT_EQ(1, loaded == matrix);
+
+  S21MappedMatrix mapped(path);
+  EXPECT_EQ(13, mapped.GetRows());
+  EXPECT_EQ(21, mapped.GetCols());
+  EXPECT_EQ(matrix(12, 20), mapped(12, 20));
+  S21Matrix doubled = mapped.View() + matrix;
+  EXPECT_EQ(1, doubled == matrix * 2.0);
+  EXPECT_THROW(mapped(13, 0), std::out_of_range);
+  std::remove(path);
+}
+
+TEST(IO, InvalidFiles) {
+  const char* path = "s21_test_matrix.bin";
+  EXPECT_THROW(S21MatrixIO::Load("s21_missing_matrix.bin"),
+               std::runtime_error);
+
+  std::FILE* file = std::fopen(path, "wb");
+  std::fputs("not a matrix file, just some text that is long enough", file);
+  std::fputs(" to hold a whole header", file);
+  std::fclose(file);
+  EXPECT_THROW(S21MatrixIO::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix mapped(path), std::runtime_error);
+
+  S21Matrix matrix(4, 4);
+  S21MatrixIO::Save(matrix, path);
+  EXPECT_EQ(0, truncate(path, 64 + 8 * 15));
+  EXPECT_THROW(S21MatrixIO::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix mapped(path), std::runtime_error);
+  std::remove(path);
+}
+
+TEST(IO, ReadText) {
+  std::istringstream csv(
+      "# exported matrix\r\n1,2.5,-3\r\n\r\n+4;5e-1;  6\n7\t8 9");
+  S21Matrix matrix = S21MatrixIO::ReadText(csv);
+  EXPECT_EQ(3, matrix.GetRows());
+  EXPECT_EQ(3, matrix.GetCols());
+  EXPECT_EQ(2.5, matrix(0, 1));
+  EXPECT_EQ(4.0, matrix(1, 0));
+  EXPECT_EQ(0.5, matrix(1, 1));
+  EXPECT_EQ(9.0, matrix(2, 2));
+
+  std::istringstream ragged("1 2 3\n4 5\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(ragged), std::runtime_error);
+  std::istringstream wide("1 2\n4 5 6\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(wide), std::runtime_error);
+  std::istringstream garbage("1 2\n4 5x\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(garbage), std::runtime_error);
+  std::istringstream empty("\n# nothing\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(empty), std::runtime_error);
+  std::istringstream signs("1 2\n+-5 6\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(signs), std::runtime_error);
+  std::istringstream gap("1,2,3\n1,,3\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(gap), std::runtime_error);
+  std::istringstream padded_gap("1;2;3\n1; ;3;\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(padded_gap), std::runtime_error);
+  std::istringstream leading(",1,2\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(leading), std::runtime_error);
+  std::istringstream trailing("1,2,\n");
+  EXPECT_THROW(S21MatrixIO::ReadText(trailing), std::runtime_error);
+}
+
+TEST(IO, TextRoundTrip) {
+  // Enough rows to cross several read chunks and storage growths
+  S21Matrix matrix(3000, 17);
+  FillPattern(matrix, 2);
+  matrix(0, 0) = 1.0 / 3.0;
+  matrix(2999, 16) = -1e-300;
+
+  std::stringstream text;
+  S21MatrixIO::WriteText(matrix, text, ',');
+  S21Matrix parsed = S21MatrixIO::ReadText(text);
+  EXPECT_EQ(3000, parsed.GetRows());
+  EXPECT_EQ(17, parsed.GetCols());
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      ASSERT_EQ(matrix(i, j), parsed(i, j));
+    }
+  }
+
+  parsed.SetRows(3001);
+  EXPECT_EQ(0.0, parsed(3000, 16));
+  EXPECT_EQ(-1e-300, parsed(2999, 16));
+}
+
+// 2D Poisson matrix on a grid x grid mesh, symmetric positive definite
+static S21SparseMatrix Poisson(int grid) {
+  std::vector<S21SparseTriplet> triplets;
+  for (int i = 0; i < grid; i++) {
+    for (int j = 0; j < grid; j++) {
+      int row = i * grid + j;
+      triplets.push_back({row, row, 4.0});
+      if (i > 0) triplets.push_back({row, row - grid, -1.0});
+      if (i + 1 < grid) triplets.push_back({row, row + grid, -1.0});
+      if (j > 0) triplets.push_back({row, row - 1, -1.0});
+      if (j + 1 < grid) triplets.push_back({row, row + 1, -1.0});
+    }
+  }
+  return S21SparseMatrix::FromTriplets(grid * grid, grid * grid, triplets);
+}
+
+TEST(Sparse, ConversionsAndAccess) {
+  S21Matrix dense(4, 5);
+  dense(0, 1) = 2;
+  dense(2, 4) = -3;
+  dense(3, 0) = 1e-9;
+  S21SparseMatrix sparse(dense);
+  EXPECT_EQ(3, sparse.GetNonZeros());
+  EXPECT_EQ(1, sparse.ToDense() == dense);
+  EXPECT_EQ(2, S21SparseMatrix(dense, 1e-6).GetNonZeros());
+  EXPECT_DOUBLE_EQ(-3, sparse(2, 4));
+  EXPECT_DOUBLE_EQ(0, sparse(2, 3));
+  EXPECT_THROW(sparse(4, 0), std::out_of_range);
+
+  S21SparseMatrix built = S21SparseMatrix::FromTriplets(
+      4, 5, {{2, 4, -1}, {0, 1, 2}, {2, 4, -2}, {3, 0, 1e-9}, {1, 1, 0}});
+  EXPECT_EQ(1, built == sparse);
+  EXPECT_EQ(3, built.GetNonZeros());
+  EXPECT_THROW(S21SparseMatrix::FromTriplets(2, 2, {{2, 0, 1}}),
+               std::out_of_range);
+
+  S21SparseMatrix transposed = sparse.Transpose();
+  EXPECT_EQ(1, transposed.ToDense() == dense.Transpose());
+}
+
+TEST(Sparse, Arithmetic) {
+  S21Matrix a(6, 7), b(7, 4), c(6, 7);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  FillPattern(c, 3);
+  for (int i = 0; i < 6; i++) a(i, (i * 3) % 7) = 0;
+  S21SparseMatrix sa(a), sb(b), sc(c);
+
+  EXPECT_EQ(1, (sa + sc).ToDense() == a + c);
+  EXPECT_EQ(1, (sa - sc).ToDense() == a - c);
+  EXPECT_EQ(1, (sa * 2.5).ToDense() == a * 2.5);
+  EXPECT_EQ(1, (sa * sb).ToDense() == a * b);
+  EXPECT_EQ(1, sa * b == a * b);
+  S21Matrix bt = b.Transpose();
+  EXPECT_EQ(1, bt * sa.Transpose() == bt * a.Transpose());
+  EXPECT_EQ(0, (sa - sa).GetNonZeros());
+
+  EXPECT_THROW(sa + sb, std::logic_error);
+  EXPECT_THROW(sa * sc, std::logic_error);
+  EXPECT_THROW(sa * a, std::logic_error);
+}
+
+TEST(Sparse, IterativeSolvers) {
+  S21SparseMatrix poisson = Poisson(20);
+  S21Matrix expected(400, 2);
+  FillPattern(expected, 5);
+  S21Matrix b = poisson * expected;
+
+  S21Matrix x = poisson.SolveCG(b);
+  EXPECT_EQ(1, x == expected);
+
+  // Non-symmetric: add a convection term below the diagonal
+  std::vector<S21SparseTriplet> extra;
+  for (int i = 1; i < 400; i++) extra.push_back({i, i - 1, -0.5});
+  S21SparseMatrix general =
+      poisson + S21SparseMatrix::FromTriplets(400, 400, extra);
+  b = general * expected;
+  x = general.SolveBiCGSTAB(b);
+  EXPECT_EQ(1, x == expected);
+
+  EXPECT_THROW(poisson.SolveCG(b, 1e-14, 2), std::runtime_error);
+  EXPECT_THROW(poisson.SolveCG(S21Matrix(3, 1)), std::logic_error);
+  EXPECT_THROW(S21SparseMatrix(2, 3).SolveBiCGSTAB(S21Matrix(2, 1)),
+               std::logic_error);
+}
+
 TEST(AccessMutate, SetColumns) {
   S21Matrix matrix(6, 12);
   matrix.SetCols(6);
@@ -323,6 +1169,646 @@ TEST(AccessMutate, SetRowsInvalid) {
   EXPECT_THROW(matrix.SetRows(0), std::invalid_argument);
 }
 
+TEST(AccessMutate, SetColsKeepsWideRows) {
+  S21Matrix matrix(3, 20);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 20; j++) matrix(i, j) = i * 100 + j;
+  }
+  matrix.SetCols(9);
+  matrix.SetRows(4);
+  EXPECT_EQ(9, matrix.GetCols());
+  EXPECT_DOUBLE_EQ(208, matrix(2, 8));
+  EXPECT_DOUBLE_EQ(0, matrix(3, 8));
+  matrix.SetCols(12);
+  EXPECT_DOUBLE_EQ(105, matrix(1, 5));
+  EXPECT_DOUBLE_EQ(0, matrix(1, 11));
+}
+
+TEST(AccessMutate, GrowRowByRow) {
+  S21Matrix matrix(1, 5);
+  for (int i = 0; i < 1000; i++) {
+    matrix.SetRows(i + 1);
+    for (int j = 0; j < 5; j++) matrix(i, j) = i * 10 + j;
+  }
+  EXPECT_EQ(1000, matrix.GetRows());
+  EXPECT_GE(matrix.GetRowCapacity(), 1000);
+  EXPECT_LT(matrix.GetRowCapacity(), 2000);
+  EXPECT_DOUBLE_EQ(4321, matrix(432, 1));
+
+  // Shrinking keeps the buffer, growing again zeroes the revived rows
+  matrix.SetRows(10);
+  EXPECT_GE(matrix.GetRowCapacity(), 1000);
+  matrix.SetRows(11);
+  EXPECT_DOUBLE_EQ(0, matrix(10, 4));
+  matrix.ShrinkToFit();
+  EXPECT_EQ(11, matrix.GetRowCapacity());
+  EXPECT_DOUBLE_EQ(94, matrix(9, 4));
+}
+
+TEST(AccessMutate, ReserveAndColumnCapacity) {
+  S21Matrix matrix(2, 3);
+  matrix(1, 2) = 7;
+  matrix.Reserve(50, 40);
+  EXPECT_EQ(2, matrix.GetRows());
+  EXPECT_EQ(3, matrix.GetCols());
+  EXPECT_GE(matrix.GetRowCapacity(), 50);
+  EXPECT_GE(matrix.GetColCapacity(), 40);
+  EXPECT_DOUBLE_EQ(7, matrix(1, 2));
+
+  matrix.SetCols(1);
+  matrix.SetCols(40);
+  EXPECT_DOUBLE_EQ(0, matrix(1, 2));
+  EXPECT_GE(matrix.GetColCapacity(), 40);
+
+  // Assignment reuses a buffer that is large enough
+  S21Matrix small(3, 3);
+  small(2, 2) = 5;
+  matrix = small;
+  EXPECT_GE(matrix.GetColCapacity(), 40);
+  EXPECT_EQ(1, matrix == small);
+  EXPECT_EQ(1, matrix * small == small * small);
+  EXPECT_THROW(matrix.Reserve(0, 1), std::invalid_argument);
+}
+
+TEST(Methods, MulMatrixBlocked) {
+  S21Matrix a(103, 301);
+  S21Matrix b(301, 77);
+  FillPattern(a, 1);
+  FillPattern(b, 5);
+  S21Matrix ref = NaiveProduct(a, b);
+  a.MulMatrix(b);
+  EXPECT_EQ(103, a.GetRows());
+  EXPECT_EQ(77, a.GetCols());
+  EXPECT_EQ(1, a == ref);
+}
+
+TEST(Methods, MulMatrixScalarKernel) {
+  S21GemmSetSimd(false);
+  S21Matrix a(45, 60);
+  S21Matrix b(60, 29);
+  FillPattern(a, 2);
+  FillPattern(b, 3);
+  S21Matrix ref = NaiveProduct(a, b);
+  EXPECT_EQ(1, a * b == ref);
+  S21GemmSetSimd(true);
+}
+
+TEST(Methods, MulMatrixStrassen) {
+  // Odd sizes exercise the peeling at several recursion levels
+  S21Matrix a(97, 83), b(83, 101);
+  FillPattern(a, 4);
+  FillPattern(b, 5);
+  S21Matrix ref = NaiveProduct(a, b);
+
+  S21Matrix c(97, 101);
+  S21StrassenGemm(97, 101, 83, &a(0, 0), &a(1, 0) - &a(0, 0), 1, &b(0, 0),
+                  &b(1, 0) - &b(0, 0), 1, &c(0, 0), &c(1, 0) - &c(0, 0), 8);
+  EXPECT_EQ(1, c == ref);
+
+  S21SetStrassenCutoff(16);
+  EXPECT_EQ(16, S21GetStrassenCutoff());
+  EXPECT_EQ(1, a * b == ref);
+  S21Matrix bt = b.Transpose();
+  EXPECT_EQ(1, a * bt.Transposed() == ref);
+  S21SetStrassenCutoff(0);
+  EXPECT_THROW(S21SetStrassenCutoff(-1), std::invalid_argument);
+}
+
+TEST(Scalar, FloatArithmeticAndProduct) {
+  S21Matrix a(103, 301), b(301, 77);
+  FillPattern(a, 1);
+  FillPattern(b, 5);
+  S21Matrix ref = NaiveProduct(a, b);
+
+  S21FloatMatrix fa(a), fb(b);
+  EXPECT_EQ(1, fa == a);
+  for (int simd = 1; simd >= 0; simd--) {
+    S21GemmSetSimd(simd);
+    S21FloatMatrix product = fa * fb;
+    for (int i = 0; i < ref.GetRows(); i++) {
+      for (int j = 0; j < ref.GetCols(); j++) {
+        EXPECT_NEAR(ref(i, j), product(i, j), 1e-3);
+      }
+    }
+  }
+  S21GemmSetSimd(true);
+
+  S21FloatMatrix sum = fa + fa * 2.0 - fa.Transposed().Transposed();
+  fa.MulNumber(2.0f);
+  EXPECT_EQ(1, sum == fa);
+}
+
+TEST(Scalar, FloatInverseAndTolerance) {
+  S21FloatMatrix matrix(3, 3), expected(3, 3);
+  float values[] = {2, -1, 0, -1, 2, -1, 0, -1, 2};
+  float inverse[] = {0.75, 0.5, 0.25, 0.5, 1, 0.5, 0.25, 0.5, 0.75};
+  for (int i = 0; i < 9; i++) {
+    matrix(i / 3, i % 3) = values[i];
+    expected(i / 3, i % 3) = inverse[i];
+  }
+  EXPECT_EQ(1, matrix.InverseMatrix() == expected);
+  EXPECT_FLOAT_EQ(4.0f, matrix.Determinant());
+
+  S21FloatMatrix close(expected);
+  close(1, 1) += 5e-5f;
+  EXPECT_EQ(1, close == expected);
+  close(1, 1) += 5e-4f;
+  EXPECT_EQ(0, close == expected);
+}
+
+TEST(Scalar, LongDoubleDeterminant) {
+  // Elimination leaves a pivot of 1e-8 computed from numbers near 1e8,
+  // which double cannot resolve
+  S21LongDoubleMatrix matrix(2, 2);
+  matrix(0, 0) = 1e8L;
+  matrix(0, 1) = 1e8L + 1;
+  matrix(1, 0) = 1e8L - 1;
+  matrix(1, 1) = 1e8L;
+  EXPECT_NEAR(1.0L, matrix.Determinant(), 1e-2L);
+  EXPECT_NEAR(1.0L, S21BasicLU<long double>(matrix).Determinant(), 1e-2L);
+
+  S21LongDoubleMatrix close(matrix);
+  close(0, 0) += 1e-6L;
+  EXPECT_EQ(0, close == matrix);
+  EXPECT_EQ(1, S21LongDoubleMatrix::kEpsilon < S21Matrix::kEpsilon);
+
+  // Factors keep long double precision through expiring and lvalue operands
+  long double third = 1.0L / 3;
+  S21LongDoubleMatrix one(1, 1);
+  one(0, 0) = 1;
+  EXPECT_EQ(third, (S21LongDoubleMatrix(one) * third)(0, 0));
+  EXPECT_EQ(third, (third * S21LongDoubleMatrix(one))(0, 0));
+  EXPECT_EQ(third, S21LongDoubleMatrix(one * third)(0, 0));
+  EXPECT_EQ(third, S21LongDoubleMatrix(third * one)(0, 0));
+}
+
+static const S21StatsRecord* FindRecord(
+    const std::vector<S21StatsRecord>& records, S21StatsOp op, int size) {
+  for (const S21StatsRecord& record : records) {
+    if (record.op == op && record.max_size == size) return &record;
+  }
+  return nullptr;
+}
+
+TEST(Stats, CountsOperations) {
+  if (!kS21StatsEnabled) GTEST_SKIP() << "built without S21_MATRIX_STATS";
+  S21StatsReset();
+  S21Matrix a(10, 12), b(12, 9);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  S21Matrix c = a * b;
+  c.MulNumber(2.0);
+  S21Matrix d = c + c * 2.0;
+
+  std::vector<S21StatsRecord> records = S21StatsSnapshot();
+  const S21StatsRecord* alloc = FindRecord(records, S21StatsOp::kMemAlloc, 16);
+  ASSERT_NE(nullptr, alloc);
+  EXPECT_EQ(4, alloc->calls);
+  // Rows wider than 8 doubles are padded to a stride of 16
+  EXPECT_EQ(static_cast<long long>(sizeof(double)) * 16 * (10 + 12 + 10 + 10),
+            alloc->bytes);
+  const S21StatsRecord* mul = FindRecord(records, S21StatsOp::kMulMatrix, 16);
+  ASSERT_NE(nullptr, mul);
+  EXPECT_EQ(1, mul->calls);
+  EXPECT_DOUBLE_EQ(2.0 * 10 * 9 * 12, mul->flops);
+  EXPECT_GE(mul->seconds, 0.0);
+  ASSERT_NE(nullptr, FindRecord(records, S21StatsOp::kMulNumber, 16));
+  ASSERT_NE(nullptr, FindRecord(records, S21StatsOp::kEvaluate, 16));
+  EXPECT_STREQ("MulMatrix", S21StatsOpName(S21StatsOp::kMulMatrix));
+
+  S21StatsReset();
+  EXPECT_TRUE(S21StatsSnapshot().empty());
+}
+
+TEST(Stats, Callback) {
+  if (!kS21StatsEnabled) GTEST_SKIP() << "built without S21_MATRIX_STATS";
+  std::vector<S21StatsEvent> events;
+  S21StatsSetCallback(
+      [&events](const S21StatsEvent& event) { events.push_back(event); });
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = matrix(1, 1) = matrix(2, 2) = 2.0;
+  EXPECT_DOUBLE_EQ(8.0, matrix.Determinant());
+  S21StatsSetCallback(nullptr);
+  S21Matrix unseen(matrix);
+
+  ASSERT_FALSE(events.empty());
+  EXPECT_EQ(S21StatsOp::kMemAlloc, events.front().op);
+  EXPECT_EQ(S21StatsOp::kDeterminant, events.back().op);
+  EXPECT_EQ(3, events.back().rows);
+  EXPECT_EQ(3, events.back().cols);
+  EXPECT_DOUBLE_EQ(18.0, events.back().flops);
+}
+
+TEST(Allocator, PoolReusesBuffers) {
+  S21SetDefaultAllocator(&S21PoolAllocator::Instance());
+  const double* first;
+  {
+    S21Matrix matrix(100, 100);
+    first = &matrix(0, 0);
+  }
+  S21Matrix a(100, 100), b(100, 100);
+  FillPattern(a, 1);
+  FillPattern(b, 2);
+  EXPECT_EQ(first, &a(0, 0));
+  // Temporaries of an expression chain keep recycling the same classes
+  for (int i = 0; i < 3; i++) a = (a * b) * 0.01 + b;
+  S21SetDefaultAllocator(nullptr);
+
+  S21Matrix plain(100, 100);
+  plain = a;
+  EXPECT_EQ(1, plain == a);
+}
+
+TEST(Allocator, ArenaScope) {
+  S21Matrix a(40, 30), result;
+  FillPattern(a, 1);
+  result.Reserve(40, 40);
+  const double* kept = &result(0, 0);
+  {
+    S21ArenaScope scope(std::size_t{1} << 16);
+    S21Matrix gram = a * a.Transpose();
+    S21Matrix scaled = gram * 0.5;
+    EXPECT_GE(scope.GetArena().GetCapacity(), std::size_t{1} << 16);
+    result = scaled;
+  }
+  EXPECT_EQ(kept, &result(0, 0));
+  S21Matrix ref = a * a.Transpose();
+  ref.MulNumber(0.5);
+  EXPECT_EQ(1, result == ref);
+
+  // Moving a temporary out of the arena copies it instead of stealing the
+  // arena's block, into the target's buffer or its own allocator's
+  S21Matrix small(2, 2);
+  {
+    S21ArenaScope scope;
+    result = a * a.Transpose();
+    small = a * a.Transpose();
+  }
+  EXPECT_EQ(kept, &result(0, 0));
+  ref.MulNumber(2.0);
+  EXPECT_DOUBLE_EQ(ref(3, 3), result(3, 3));
+  EXPECT_EQ(1, result == ref);
+  EXPECT_EQ(1, small == ref);
+
+  // So do copying a larger result and growing a matrix declared before the
+  // scope; the next arena reuses the memory the first one gave back
+  S21Matrix outer(2, 2), grown(3, 3);
+  grown(2, 2) = 7.0;
+  {
+    S21ArenaScope scope;
+    S21Matrix inner = a * a.Transpose();
+    outer = inner;
+    grown.SetRows(100);
+    grown.Reserve(10, 200);
+  }
+  {
+    S21ArenaScope scope;
+    S21Matrix noise(100, 200);
+    FillPattern(noise, 3);
+  }
+  EXPECT_EQ(1, outer == ref);
+  EXPECT_EQ(100, grown.GetRows());
+  EXPECT_DOUBLE_EQ(7.0, grown(2, 2));
+  EXPECT_DOUBLE_EQ(0.0, grown(99, 2));
+
+  S21ArenaAllocator arena(256);
+  void* first = arena.Allocate(100);
+  arena.Deallocate(first, 100);
+  EXPECT_EQ(first, arena.Allocate(100));
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(arena.Allocate(1000)) %
+                    S21Allocator::kAlignment);
+  arena.Release();
+  EXPECT_EQ(0u, arena.GetCapacity());
+}
+
+TEST(Allocator, HugePages) {
+  S21AllocatorScope scope(S21HugePageAllocator::Instance());
+  S21Matrix large(600, 600), small(3, 3);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(&large(0, 0)) %
+                    S21HugePageAllocator::kHugePageSize);
+  FillPattern(large, 1);
+  large.SetRows(700);
+  S21Matrix moved(std::move(large));
+  EXPECT_EQ(700, moved.GetRows());
+  EXPECT_DOUBLE_EQ(0.0, moved(699, 599));
+  small(1, 1) = 2.0;
+  EXPECT_DOUBLE_EQ(2.0, small(1, 1));
+}
+
+TEST(CopyOnWrite, SharesUntilWrite) {
+  S21SetCopyOnWrite(true);
+  S21Matrix a(50, 40);
+  FillPattern(a, 1);
+  S21SetCopyOnWrite(false);
+
+  S21Matrix b(a), c(2, 2);
+  c = b;
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_TRUE(c.IsShared());
+  EXPECT_EQ(50, c.GetRows());
+  EXPECT_DOUBLE_EQ(std::as_const(a)(1, 1), std::as_const(c)(1, 1));
+  EXPECT_TRUE(c.IsShared());
+
+  b(0, 0) = 100.0;
+  EXPECT_FALSE(b.IsShared());
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_DOUBLE_EQ(100.0, b(0, 0));
+  EXPECT_DOUBLE_EQ(c(0, 0), a(0, 0));
+  EXPECT_FALSE(a.IsShared());
+
+  S21Matrix d(c);
+  d += a;
+  d.SetRows(60);
+  EXPECT_DOUBLE_EQ(2 * c(1, 1), d(1, 1));
+  EXPECT_DOUBLE_EQ(0.0, d(59, 0));
+  S21Matrix e(c);
+  e.TransposeInPlace();
+  EXPECT_EQ(1, e == c.Transpose());
+  S21Matrix f(c);
+  f = c.Transposed() * 2.0;
+  EXPECT_EQ(1, f == c.Transpose() * 2.0);
+  EXPECT_DOUBLE_EQ(a(3, 4), c(3, 4));
+
+  // Scratch copies inside the library detach before they are factored
+  S21SetCopyOnWrite(true);
+  S21Matrix g(30, 30);
+  FillPattern(g, 2);
+  for (int i = 0; i < 30; i++) g(i, i) += 30;
+  S21Matrix saved(g);
+  S21LU lu(g);
+  EXPECT_NEAR(g.Determinant(), lu.Determinant(),
+              1e-9 * S21Fabs(lu.Determinant()));
+  S21Matrix identity = g * g.InverseMatrix();
+  EXPECT_EQ(1, identity == lu.Solve(g));
+  g.CalcComplements();
+  EXPECT_EQ(1, g == saved);
+  S21SetCopyOnWrite(false);
+
+  S21Matrix plain(3, 3), copy(plain);
+  EXPECT_FALSE(plain.IsShared());
+}
+
+TEST(CopyOnWrite, SnapshotsAcrossThreads) {
+  S21SetCopyOnWrite(true);
+  S21Matrix source(64, 64);
+  FillPattern(source, 1);
+  S21SetCopyOnWrite(false);
+
+  std::vector<double> sums(4, 0.0);
+  auto work = [&sums](S21Matrix snapshot, int t) {
+    if (t % 2) snapshot.MulNumber(t);
+    const S21Matrix& read = snapshot;
+    for (int i = 0; i < 64; i++) sums[t] += read(i, i);
+  };
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; t++) workers.emplace_back(work, source, t);
+  for (std::thread& worker : workers) worker.join();
+
+  double trace = 0;
+  for (int i = 0; i < 64; i++) trace += source(i, i);
+  for (int t = 0; t < 4; t++) {
+    EXPECT_NEAR(t % 2 ? t * trace : trace, sums[t], 1e-9);
+  }
+  EXPECT_FALSE(source.IsShared());
+
+  // Arena buffers are never shared, so results still escape by copying
+  S21SetCopyOnWrite(true);
+  S21Matrix kept(64, 64);
+  {
+    S21ArenaScope scope;
+    S21Matrix temp = source * 2.0;
+    kept = temp;
+    EXPECT_FALSE(temp.IsShared());
+  }
+  S21SetCopyOnWrite(false);
+  EXPECT_DOUBLE_EQ(2 * source(5, 7), kept(5, 7));
+}
+
+static S21Matrix General(const S21Matrix& matrix) {
+  S21Matrix result(matrix);
+  result.SetStructure(S21Structure::kGeneral);
+  return result;
+}
+
+TEST(Structure, DiagonalAndTriangular) {
+  S21Matrix d(5, 5);
+  for (int i = 0; i < 5; i++) d(i, i) = i + 1;
+  d.SetStructure(S21Structure::kDiagonal);
+  EXPECT_DOUBLE_EQ(120.0, d.Determinant());
+  S21Matrix d_inv = d.InverseMatrix();
+  EXPECT_EQ(S21Structure::kDiagonal, d_inv.GetStructure());
+  EXPECT_EQ(1, d_inv == General(d).InverseMatrix());
+  S21Matrix b(5, 3);
+  FillPattern(b, 1);
+  EXPECT_EQ(1, d * b == General(d) * b);
+  EXPECT_EQ(S21Structure::kDiagonal, d.Transpose().GetStructure());
+
+  S21Matrix l(6, 6);
+  FillPattern(l, 2);
+  for (int i = 0; i < 6; i++) {
+    l(i, i) = 3.0 + i;
+    for (int j = i + 1; j < 6; j++) l(i, j) = 0.0;
+  }
+  l.SetStructure(S21Structure::kLowerTriangular);
+  EXPECT_NEAR(General(l).Determinant(), l.Determinant(), 1e-9);
+  S21Matrix l_inv = l.InverseMatrix();
+  EXPECT_EQ(S21Structure::kLowerTriangular, l_inv.GetStructure());
+  EXPECT_EQ(1, l_inv == General(l).InverseMatrix());
+
+  S21Matrix u = l.Transpose();
+  EXPECT_EQ(S21Structure::kUpperTriangular, u.GetStructure());
+  EXPECT_EQ(0, u.GetLowerBandwidth());
+  EXPECT_EQ(1, u.InverseMatrix() == General(u).InverseMatrix());
+  u.TransposeInPlace();
+  EXPECT_EQ(S21Structure::kLowerTriangular, u.GetStructure());
+
+  // In-place operations forget the structure, scaling and element reads
+  // keep it
+  l.MulNumber(2.0);
+  EXPECT_EQ(S21Structure::kLowerTriangular, l.GetStructure());
+  if (l(5, 0) > 0) l(5, 0) = 1.0;
+  EXPECT_EQ(S21Structure::kLowerTriangular, l.GetStructure());
+  l.SumMatrix(l);
+  EXPECT_EQ(S21Structure::kGeneral, l.GetStructure());
+  EXPECT_EQ(5, l.GetUpperBandwidth());
+
+  S21Matrix wide(2, 3);
+  EXPECT_THROW(wide.SetStructure(S21Structure::kDiagonal), std::logic_error);
+  EXPECT_THROW(d.SetStructure(S21Structure::kBanded), std::invalid_argument);
+  EXPECT_THROW(d.SetBandwidth(5, 0), std::invalid_argument);
+}
+
+TEST(Structure, PositiveDefinite) {
+  S21Matrix b(40, 40);
+  FillPattern(b, 3);
+  S21Matrix a = b.Transposed() * b;
+  for (int i = 0; i < 40; i++) a(i, i) += 1.0;
+  S21Matrix general(a);
+  a.SetStructure(S21Structure::kPositiveDefinite);
+
+  double det = general.Determinant();
+  EXPECT_NEAR(det, a.Determinant(), 1e-9 * S21Fabs(det));
+  S21Matrix inv = a.InverseMatrix();
+  EXPECT_EQ(S21Structure::kPositiveDefinite, inv.GetStructure());
+  EXPECT_EQ(1, inv == general.InverseMatrix());
+  EXPECT_EQ(S21Structure::kPositiveDefinite, a.Transpose().GetStructure());
+
+  a.MulNumber(-1.0);
+  EXPECT_EQ(S21Structure::kSymmetric, a.GetStructure());
+  EXPECT_NEAR(det, a.Determinant(), 1e-9 * S21Fabs(det));
+
+  // Symmetric but indefinite: only kPositiveDefinite tries Cholesky, and a
+  // wrong declaration falls back to LU
+  S21Matrix s(2, 2);
+  s(0, 0) = 1, s(0, 1) = 2, s(1, 0) = 2, s(1, 1) = 1;
+  EXPECT_EQ(S21Structure::kSymmetric, s.DetectStructure());
+  EXPECT_DOUBLE_EQ(-3.0, s.Determinant());
+  EXPECT_EQ(1, s.InverseMatrix() == General(s).InverseMatrix());
+  s.SetStructure(S21Structure::kPositiveDefinite);
+  EXPECT_DOUBLE_EQ(-3.0, s.Determinant());
+
+  // Pivots below kEpsilon count as zero on every path, tagged or not
+  S21Matrix tiny(2, 2);
+  tiny(0, 0) = 1e-7, tiny(1, 1) = 1;
+  EXPECT_EQ(0, tiny.Determinant());
+  for (S21Structure structure :
+       {S21Structure::kDiagonal, S21Structure::kUpperTriangular,
+        S21Structure::kSymmetric, S21Structure::kPositiveDefinite}) {
+    tiny.SetStructure(structure);
+    EXPECT_EQ(0, tiny.Determinant());
+  }
+  EXPECT_THROW(tiny.InverseMatrix(), std::logic_error);
+  S21Matrix tridiagonal(10, 10);
+  for (int i = 0; i < 10; i++) tridiagonal(i, i) = i == 4 ? 1e-7 : 2;
+  tridiagonal.SetBandwidth(1, 1);
+  EXPECT_EQ(0, tridiagonal.Determinant());
+}
+
+TEST(Structure, BandedAndDetected) {
+  int n = 200;
+  S21Matrix a(n, n), sym(n, n);
+  for (int i = 0; i < n; i++) {
+    a(i, i) = 4.0 + i % 3;
+    sym(i, i) = 4.0 + i % 3;
+    if (i + 1 < n) {
+      a(i, i + 1) = -1.0;
+      a(i + 1, i) = -2.0 + i % 5 * 0.1;
+      sym(i, i + 1) = sym(i + 1, i) = -1.5;
+    }
+  }
+  EXPECT_EQ(S21Structure::kBanded, a.DetectStructure());
+  EXPECT_EQ(1, a.GetLowerBandwidth());
+  EXPECT_EQ(1, a.GetUpperBandwidth());
+  EXPECT_EQ(S21Structure::kSymmetric, sym.DetectStructure());
+  EXPECT_EQ(1, sym.GetLowerBandwidth());
+
+  double det = General(a).Determinant();
+  EXPECT_NEAR(det, a.Determinant(), 1e-9 * S21Fabs(det));
+  det = General(sym).Determinant();
+  EXPECT_NEAR(det, sym.Determinant(), 1e-9 * S21Fabs(det));
+
+  S21Matrix right(n, 30), left(30, n);
+  FillPattern(right, 1);
+  FillPattern(left, 2);
+  EXPECT_EQ(1, a * right == General(a) * right);
+  EXPECT_EQ(1, left * a == left * General(a));
+  S21Matrix square = a * sym;
+  EXPECT_EQ(S21Structure::kBanded, square.GetStructure());
+  EXPECT_EQ(2, square.GetUpperBandwidth());
+  EXPECT_EQ(1, square == General(a) * General(sym));
+  S21Matrix product(left);
+  product.MulMatrix(a);
+  EXPECT_EQ(1, product == left * General(a));
+
+  S21Matrix bidiagonal(4, 4);
+  for (int i = 0; i < 4; i++) bidiagonal(i, i) = i + 2;
+  for (int i = 0; i < 3; i++) bidiagonal(i, i + 1) = 7;
+  EXPECT_EQ(S21Structure::kBanded, bidiagonal.DetectStructure());
+  EXPECT_DOUBLE_EQ(120.0, bidiagonal.Determinant());
+  EXPECT_EQ(S21Structure::kGeneral, right.DetectStructure());
+}
+
+TEST(SymmetricMatrix, Packed) {
+  S21Matrix b(30, 30);
+  FillPattern(b, 4);
+  S21Matrix dense = b.Transposed() * b;
+  for (int i = 0; i < 30; i++) dense(i, i) += 1.0;
+  S21SymmetricMatrix packed(dense);
+  EXPECT_EQ(30, packed.GetSize());
+  EXPECT_EQ(1, packed.ToDense() == dense);
+  EXPECT_EQ(S21Structure::kSymmetric, packed.ToDense().GetStructure());
+
+  double det = dense.Determinant();
+  EXPECT_NEAR(det, packed.Determinant(), 1e-9 * S21Fabs(det));
+  EXPECT_EQ(1, packed.InverseMatrix().ToDense() == dense.InverseMatrix());
+  S21Matrix rhs(30, 7);
+  FillPattern(rhs, 5);
+  EXPECT_EQ(1, packed * rhs == dense * rhs);
+
+  S21SymmetricMatrix twice(packed);
+  twice.SumMatrix(packed);
+  packed.MulNumber(2.0);
+  EXPECT_EQ(1, twice == packed);
+  twice.SubMatrix(packed);
+  EXPECT_DOUBLE_EQ(0.0, twice(3, 4));
+
+  S21SymmetricMatrix small(2);
+  small(0, 0) = 1, small(1, 0) = 2, small(1, 1) = 1;
+  EXPECT_DOUBLE_EQ(2.0, small(0, 1));
+  EXPECT_DOUBLE_EQ(-3.0, small.Determinant());
+  EXPECT_EQ(1, small.InverseMatrix().ToDense() ==
+                   General(small.ToDense()).InverseMatrix());
+
+  // diag(1e-7, 1e7) is positive definite with determinant 1, but its first
+  // pivot is below kEpsilon, so both paths treat it as singular
+  S21SymmetricMatrix tiny_pivot(2);
+  tiny_pivot(0, 0) = 1e-7, tiny_pivot(1, 1) = 1e7;
+  EXPECT_EQ(0.0, tiny_pivot.Determinant());
+  EXPECT_EQ(0.0, tiny_pivot.ToDense().Determinant());
+  EXPECT_THROW(tiny_pivot.InverseMatrix(), std::logic_error);
+  EXPECT_THROW(tiny_pivot.ToDense().InverseMatrix(), std::logic_error);
+
+  EXPECT_THROW(S21SymmetricMatrix(0), std::invalid_argument);
+  EXPECT_THROW(S21SymmetricMatrix(S21Matrix(2, 3)), std::logic_error);
+  EXPECT_THROW(small(2, 0), std::out_of_range);
+  EXPECT_THROW(small * rhs, std::logic_error);
+  EXPECT_THROW(small.SumMatrix(packed), std::logic_error);
+}
+
+TEST(Threads, SetNumThreads) {
+  int saved = S21GetNumThreads();
+  S21SetNumThreads(3);
+  EXPECT_EQ(3, S21GetNumThreads());
+  EXPECT_THROW(S21SetNumThreads(0), std::invalid_argument);
+  S21SetNumThreads(saved);
+}
+
+TEST(Threads, ParallelMulAndElementwise) {
+  int saved = S21GetNumThreads();
+  S21SetNumThreads(4);
+  S21Matrix a(300, 200);
+  S21Matrix b(200, 310);
+  FillPattern(a, 4);
+  FillPattern(b, 9);
+  S21Matrix ref = NaiveProduct(a, b);
+  S21Matrix product = a * b;
+  EXPECT_EQ(1, product == ref);
+
+  S21Matrix sum(product);
+  sum += product;
+  sum -= ref;
+  sum *= 2.0;
+  ref *= 2.0;
+  EXPECT_EQ(1, sum == ref);
+
+  // Fewer rows than one row block: the threads split the columns instead
+  S21Matrix wide_a(20, 300), wide_b(300, 1000);
+  FillPattern(wide_a, 5);
+  FillPattern(wide_b, 6);
+  EXPECT_EQ(1, wide_a * wide_b == NaiveProduct(wide_a, wide_b));
+  S21SetNumThreads(saved);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
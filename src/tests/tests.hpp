@@ -3,6 +3,20 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
+#include "../s21_allocator.hpp"
+#include "../s21_fixed_matrix.hpp"
+#include "../s21_gemm.hpp"
+#include "../s21_lu.hpp"
+#include "../s21_matrix_batch.hpp"
+#include "../s21_matrix_io.hpp"
 #include "../s21_matrix_oop.hpp"
+#include "../s21_matrix_stats.hpp"
+#include "../s21_sparse_matrix.hpp"
+#include "../s21_strassen.hpp"
+#include "../s21_symmetric_matrix.hpp"
+#include "../s21_thread_pool.hpp"
 
 #endif